@@ -0,0 +1,165 @@
+/******************************************************************************
+	 * File: arc_length.cpp
+	 * Description: Contains arc length parameterization of paths.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include "arc_length.h"
+#include "geometry.h"
+
+namespace Geometry
+{
+	namespace
+	{
+		// 5 point Gauss-Legendre rule on [-1, 1]
+		const double gauss_nodes[5] = { -0.9061798459386640, -0.5384693101056831, 0.0,
+										0.5384693101056831, 0.9061798459386640 };
+		const double gauss_weights[5] = { 0.2369268850561891, 0.4786286704993665, 0.5688888888888889,
+										  0.4786286704993665, 0.2369268850561891 };
+
+		float hermite(float p0, float p1, float m0, float m1, float u)
+		{
+			float u2 = u * u;
+			float u3 = u2 * u;
+			return (2.0f * u3 - 3.0f * u2 + 1.0f) * p0 + (u3 - 2.0f * u2 + u) * m0 +
+				   (-2.0f * u3 + 3.0f * u2) * p1 + (u3 - u2) * m1;
+		}
+
+		/**
+		 * Slope of Hermite segment limited to [0, 3 * secant], keeps it monotone
+		 */
+		float limit_slope(float slope, float secant)
+		{
+			return slope < 0.0f ? 0.0f : (slope > 3.0f * secant ? 3.0f * secant : slope);
+		}
+	}
+
+	Arc_Length_Table::Arc_Length_Table(const Path& path, size_t segments)
+	{
+		if (segments == 0)
+		{
+			segments = 1;
+		}
+		const double dt = 1.0 / static_cast<double>(segments);
+
+		lengths.resize(segments + 1);
+		speeds.resize(segments + 1);
+		double length = 0.0;
+		lengths[0] = 0.0f;
+		for (size_t i = 0; i < segments; ++i)
+		{
+			double t0 = static_cast<double>(i) * dt;
+			double segment_length = 0.0;
+			for (int node = 0; node < 5; ++node)
+			{
+				float t = static_cast<float>(t0 + 0.5 * dt * (gauss_nodes[node] + 1.0));
+				segment_length += gauss_weights[node] * path.get_tangent(t).length();
+			}
+			length += 0.5 * dt * segment_length;
+			lengths[i + 1] = static_cast<float>(length);
+		}
+		for (size_t i = 0; i <= segments; ++i)
+		{
+			speeds[i] = path.get_tangent(static_cast<float>(static_cast<double>(i) * dt)).length();
+		}
+
+		// Bucket b starts in segment holding distance b * length / segments
+		buckets.resize(segments);
+		const float total = lengths.back();
+		bucket_scale = total > 0.0f ? static_cast<float>(segments) / total : 0.0f;
+		size_t segment = 0;
+		for (size_t b = 0; b < segments; ++b)
+		{
+			float distance = total * static_cast<float>(b) / static_cast<float>(segments);
+			while (segment + 1 < segments && lengths[segment + 1] < distance)
+			{
+				++segment;
+			}
+			buckets[b] = segment;
+		}
+	}
+
+	size_t Arc_Length_Table::get_segments_number() const
+	{
+		return buckets.size();
+	}
+
+	float Arc_Length_Table::get_length() const
+	{
+		return lengths.empty() ? 0.0f : lengths.back();
+	}
+
+	float Arc_Length_Table::get_distance(float t) const
+	{
+		const size_t segments = buckets.size();
+		if (segments == 0)
+		{
+			return 0.0f;
+		}
+		t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+
+		float x = t * static_cast<float>(segments);
+		size_t i = static_cast<size_t>(x);
+		i = i < segments ? i : segments - 1;
+		float u = x - static_cast<float>(i);
+
+		// Slopes per unit u, i.e. |tangent| * dt
+		float secant = lengths[i + 1] - lengths[i];
+		float dt = 1.0f / static_cast<float>(segments);
+		float m0 = limit_slope(speeds[i] * dt, secant);
+		float m1 = limit_slope(speeds[i + 1] * dt, secant);
+		return hermite(lengths[i], lengths[i + 1], m0, m1, u);
+	}
+
+	float Arc_Length_Table::get_parameter(size_t segment, float distance) const
+	{
+		const float dt = 1.0f / static_cast<float>(buckets.size());
+		const float t0 = static_cast<float>(segment) * dt;
+		const float h = lengths[segment + 1] - lengths[segment];
+		if (h <= 0.0f)
+		{
+			return t0;
+		}
+		float u = (distance - lengths[segment]) / h;
+
+		// Slopes per unit u, i.e. h / |tangent|, steepest where tangent vanishes
+		float m0 = speeds[segment] > 0.0f ? limit_slope(h / speeds[segment], dt) : 3.0f * dt;
+		float m1 = speeds[segment + 1] > 0.0f ? limit_slope(h / speeds[segment + 1], dt) : 3.0f * dt;
+		return hermite(t0, t0 + dt, m0, m1, u);
+	}
+
+	float Arc_Length_Table::get_parameter(float distance) const
+	{
+		const size_t segments = buckets.size();
+		if (segments == 0)
+		{
+			return 0.0f;
+		}
+		const float total = lengths.back();
+		distance = distance < 0.0f ? 0.0f : (distance > total ? total : distance);
+
+		size_t b = static_cast<size_t>(distance * bucket_scale);
+		size_t i = buckets[b < segments ? b : segments - 1];
+		while (i + 1 < segments && lengths[i + 1] < distance)
+		{
+			++i;
+		}
+		while (i > 0 && lengths[i] > distance)
+		{
+			--i;
+		}
+		return get_parameter(i, distance);
+	}
+
+	void Arc_Length_Table::get_parameters(const float* distances, size_t count, float* result) const
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			result[i] = get_parameter(distances[i]);
+		}
+	}
+}
@@ -0,0 +1,61 @@
+/******************************************************************************
+	 * File: arc_length.h
+	 * Description: Contains arc length parameterization of paths.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <vector>
+
+namespace Geometry
+{
+	class Path;
+
+	/**
+	* @class Arc_Length_Table
+	* Distance along path <-> path parameter t.
+	* Path is split into segments of equal t, length of each one is
+	* integrated by 5 point Gauss-Legendre rule. Inside segment distance(t)
+	* and t(distance) are cubic Hermite with slopes |tangent| and 1 / |tangent|,
+	* limited to keep them monotone, so error drops as segments^4 on smooth path.
+	* Inverse query is O(1): distance buckets point to their first segment.
+	*/
+	class Arc_Length_Table
+	{
+		// lengths[i] - distance from start to t = i / segments
+		std::vector<float> lengths;
+		// speeds[i] - |tangent| at t = i / segments
+		std::vector<float> speeds;
+		// buckets[b] - segment of distance b * length / segments
+		std::vector<size_t> buckets;
+		float bucket_scale = 0.0f;
+
+		float get_parameter(size_t segment, float distance) const;
+
+	public:
+		static const size_t default_segments = 256;
+
+		Arc_Length_Table() {};
+		explicit Arc_Length_Table(const Path& path, size_t segments = default_segments);
+
+		size_t get_segments_number() const;
+		float get_length() const;
+		/**
+		 * Distance from start to t
+		 */
+		float get_distance(float t) const;
+		/**
+		 * Inverse of get_distance, distance is clamped to [0, length]
+		 */
+		float get_parameter(float distance) const;
+		/**
+		 * result[i] = get_parameter(distances[i])
+		 */
+		void get_parameters(const float* distances, size_t count, float* result) const;
+	};
+}
@@ -2,9 +2,9 @@
 
 Camera::Camera(int wndWidth, int wndHeight)
 {
-	eye = XMVectorSet(10.0f, 10.0f, -10.0f, 0.0f);
-	at = XMVectorSet(0.0f, 2.0f, 0.0f, 0.0f);
-	up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+	eye = Math_3d::Vector_3d(10.0f, 10.0f, -10.0f);
+	at = Math_3d::Vector_3d(0.0f, 2.0f, 0.0f);
+	up = Math_3d::Vector_3d(0.0f, 1.0f, 0.0f);
 
 	pos = Math_3d::Vector_3d(0.0f, 1.0f, -1.0f);
 
@@ -15,19 +15,30 @@ Camera::Camera(int wndWidth, int wndHeight)
 
 	viewPoint = { 0.0f, 0.0f, 0.0f };
 
-	_view = XMMatrixLookAtLH(eye, at, up);
-	_projection = XMMatrixPerspectiveFovLH(XM_PIDIV2, (FLOAT)wndWidth / (FLOAT)wndHeight, 0.01f, 100.0f);
+	_view = Math_3d::look_at_lh(eye, at, up);
+	_projection = Math_3d::perspective_fov_lh(Math_3d::pi / 2.0f, (FLOAT)wndWidth / (FLOAT)wndHeight, 0.01f, 100.0f);
 }
 
 XMMATRIX Camera::view()
+{
+	// Math_3d::Matrix_4x4 has XMMATRIX layout
+	return XMMATRIX(view_matrix().data());
+}
+
+XMMATRIX Camera::projection()
+{
+	return XMMATRIX(_projection.data());
+}
+
+Math_3d::Matrix_4x4 Camera::view_matrix()
 {
 	camera_mutex.lock();
-	XMMATRIX tmp_view = _view;
+	Math_3d::Matrix_4x4 tmp_view = _view;
 	camera_mutex.unlock();
 	return tmp_view;
 }
 
-XMMATRIX& Camera::projection()
+const Math_3d::Matrix_4x4& Camera::projection_matrix()
 {
 	return _projection;
 }
@@ -45,17 +56,17 @@ void Camera::move(int _x, int _y)
 	if (yAngle < -89.0f)
 		yAngle = -89.0f;
 
-	float xAngleRad = xAngle * XM_PI / 180.0f;
-	float yAngleRad = yAngle * XM_PI / 180.0f;
+	float xAngleRad = Math_3d::degree_to_radian(xAngle);
+	float yAngleRad = Math_3d::degree_to_radian(yAngle);
 
 	float vx = cos(xAngleRad) * cos(yAngleRad);
 	float vy = sin(yAngleRad);
 	float vz = sin(xAngleRad) * cos(yAngleRad);
 
-	eye = XMVectorSet(vx * radius, vy * radius, vz * radius, 0.0f);
+	eye = Math_3d::Vector_3d(vx * radius, vy * radius, vz * radius);
 
 	camera_mutex.lock();
-	_view = XMMatrixLookAtLH(eye, at, up);
+	_view = Math_3d::look_at_lh(eye, at, up);
 	camera_mutex.unlock();
 
 	pos = Math_3d::Vector_3d(vx * radius, vy * radius, vz * radius);
@@ -7,6 +7,7 @@
 #include <mutex>
 
 #include "math_3d.h"
+#include "math_3d_matrix.h"
 
 struct cameraDef
 {
@@ -20,15 +21,15 @@ struct cameraDef
 class Camera
 {
 
-	XMVECTOR eye;
-	XMVECTOR at;
-	XMVECTOR up;
+	Math_3d::Vector_3d eye;
+	Math_3d::Vector_3d at;
+	Math_3d::Vector_3d up;
 
 	Math_3d::Vector_3d pos;
 	Math_3d::Vector_3d viewPoint;
 
-	XMMATRIX _view;
-	XMMATRIX _projection;
+	Math_3d::Matrix_4x4 _view;
+	Math_3d::Matrix_4x4 _projection;
 
 	float xAngle = 0.0f;
 	float yAngle = -90.0f;
@@ -45,7 +46,11 @@ public:
 
 	XMMATRIX view();
 
-	XMMATRIX& projection();
+	XMMATRIX projection();
+
+	Math_3d::Matrix_4x4 view_matrix();
+
+	const Math_3d::Matrix_4x4& projection_matrix();
 
 	void move(int x, int y);
 
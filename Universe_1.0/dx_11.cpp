@@ -12,6 +12,8 @@ DX_11::~DX_11()
 {
 	if (immediateContext) immediateContext->ClearState();
 	if (vertexLayout) vertexLayout->Release();
+	if (vertexLayout_half) vertexLayout_half->Release();
+	if (vertexLayout_fixed) vertexLayout_fixed->Release();
 	if (renderTargetView) renderTargetView->Release();
 	if (swapChain) swapChain->Release();
 	if (immediateContext) immediateContext->Release();
@@ -267,6 +269,43 @@ bool DX_11::createShader(wstring path, Shader* shader)
 	// Установка формата буфера
 	immediateContext->IASetInputLayout(vertexLayout);
 
+	// Вершинный шейдер для Compact_Vertex
+	blob = NULL;
+	if (!compileShader(path, "VS_Compact", "vs_4_0", &blob))
+	{
+		MessageBox(NULL, L"The FX file cannot be compiled.  Please run this executable from the directory that contains the FX file.", L"Error", MB_OK);
+		return false;
+	}
+
+	if (d3dDevice->CreateVertexShader(blob->GetBufferPointer(), blob->GetBufferSize(), NULL, &shader->vertexShader_compact) < 0)
+	{
+		blob->Release();
+		return false;
+	}
+
+	// Форматы Compact_Vertex: позиция half или unorm16, нормаль octahedral snorm16
+	D3D11_INPUT_ELEMENT_DESC layout_half[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, 8, D3D11_INPUT_PER_VERTEX_DATA, 0 }
+	};
+	D3D11_INPUT_ELEMENT_DESC layout_fixed[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, 8, D3D11_INPUT_PER_VERTEX_DATA, 0 }
+	};
+
+	hr = d3dDevice->CreateInputLayout(layout_half, ARRAYSIZE(layout_half), blob->GetBufferPointer(),
+		blob->GetBufferSize(), &vertexLayout_half);
+	if (SUCCEEDED(hr))
+	{
+		hr = d3dDevice->CreateInputLayout(layout_fixed, ARRAYSIZE(layout_fixed), blob->GetBufferPointer(),
+			blob->GetBufferSize(), &vertexLayout_fixed);
+	}
+	blob->Release();
+	if (FAILED(hr))
+		return false;
+
 	// Пиксельный шейдер
 	blob = NULL;
 	if (compileShader(path, "PS", "ps_4_0", &blob) < 0)
@@ -336,9 +375,12 @@ void DX_11::render()
 	//
 	// Установка констант шейдера
 	//
-	localConstantBuffer.mWorld = XMMatrixTranspose(mWorld);
-	localConstantBuffer.mView = XMMatrixTranspose(camera->view());
-	localConstantBuffer.mProjection = XMMatrixTranspose(camera->projection());
+	const Math_3d::Matrix_4x4 view = camera->view_matrix();
+	const Math_3d::Matrix_4x4& projection = camera->projection_matrix();
+	localConstantBuffer.mView = XMMatrixTranspose(XMMATRIX(view.data()));
+	localConstantBuffer.mProjection = XMMatrixTranspose(XMMATRIX(projection.data()));
+	const Math_3d::Frustum frustum(view * projection);
+	const Math_3d::Vector_3d cameraPosition = Math_3d::get_view_position(view);
 
 	localConstantBuffer.light_pos = { 50.0f, 70.0f, 50.0f, 0.0f };
 	localConstantBuffer.light_color = { 1.0f, 1.0f, 1.0f, 1.0f };
@@ -362,15 +404,51 @@ void DX_11::render()
 	immediateContext->VSSetShader(shader->vertexShader, NULL, 0);
 	immediateContext->PSSetShader(shader->pixelShader, NULL, 0);
 
+	// Отсечение объектов по пирамиде видимости, четыре рамки за раз
+	objectBoxes.clear();
+	for (const auto& it : objects)
+	{
+		objectBoxes.push_back(it.first->mesh_bounds.low, it.first->mesh_bounds.high, it.first->transform.get_matrix());
+	}
+	visibleObjects.resize(objects.size());
+	const size_t visibleNumber = frustum.cull_boxes(objectBoxes, visibleObjects.data());
+
 	//float i = 1.0f;
-	for (auto it : objects)
+	for (size_t v = 0; v < visibleNumber; ++v)
 	{
+		const auto& it = objects[visibleObjects[v]];
+		// Положение объекта, вершины не меняются
+		const Math_3d::Matrix_4x4& world = it.first->transform.get_matrix();
+		localConstantBuffer_2.mWorld = XMMatrixTranspose(XMMATRIX(world.data()));
+		localConstantBuffer_2.mWorldNormal = XMMatrixTranspose(XMMATRIX(it.first->transform.get_normal_matrix().data()));
+
 		localConstantBuffer_2.color.x = it.second->color.x;
 		localConstantBuffer_2.color.y = it.second->color.y;
 		localConstantBuffer_2.color.z = it.second->color.z;
 		localConstantBuffer_2.color.w = it.second->color.w;
+
+		const Geometry::Vertex_Bounds& bounds = it.first->bounds;
+		localConstantBuffer_2.bounds_offset = { bounds.offset.x, bounds.offset.y, bounds.offset.z, 0.0f };
+		localConstantBuffer_2.bounds_scale = { bounds.scale.x, bounds.scale.y, bounds.scale.z, 0.0f };
 		immediateContext->UpdateSubresource(constantBuffer_2, 0, NULL, &localConstantBuffer_2, 0, 0);
 
+		// Формат вершин объекта
+		switch (it.second->format)
+		{
+		case Geometry::Vertex_Format::half:
+			immediateContext->IASetInputLayout(vertexLayout_half);
+			immediateContext->VSSetShader(shader->vertexShader_compact, NULL, 0);
+			break;
+		case Geometry::Vertex_Format::fixed:
+			immediateContext->IASetInputLayout(vertexLayout_fixed);
+			immediateContext->VSSetShader(shader->vertexShader_compact, NULL, 0);
+			break;
+		default:
+			immediateContext->IASetInputLayout(vertexLayout);
+			immediateContext->VSSetShader(shader->vertexShader, NULL, 0);
+			break;
+		}
+
 		////
 		//// Установка шейдера
 		////
@@ -386,12 +464,12 @@ void DX_11::render()
 		immediateContext->PSSetConstantBuffers(0, 2, cbarr);
 
 		// Установка вершинного буфера
-		UINT stride = sizeof(Geometry::Vertex);
+		UINT stride = it.second->stride;
 		UINT offset = 0;
 		immediateContext->IASetVertexBuffers(0, 1, &it.second->vertexBuffer, &stride, &offset);
 
 		// Установка индексного буфера
-		immediateContext->IASetIndexBuffer(it.second->indexBuffer, DXGI_FORMAT_R32_UINT, 0);
+		immediateContext->IASetIndexBuffer(it.second->indexBuffer, it.second->indexFormat, 0);
 
 		// Установка типа примитив
 		immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -400,7 +478,29 @@ void DX_11::render()
 		// Рендер
 		//
 		
-		immediateContext->DrawIndexed(it.second->size, 0, 0);
+		// Уровень детализации по размеру объекта на экране
+		Geometry::Lod_Level lod;
+		lod.indices_number = it.second->size;
+		lod.meshlets_number = it.first->meshlets.size();
+		if (!it.first->lods.empty())
+		{
+			lod = it.first->lods[Geometry::select_lod(*it.first, view, projection)];
+		}
+
+		if (it.first->meshlets.empty())
+		{
+			immediateContext->DrawIndexed(static_cast<UINT>(lod.indices_number), static_cast<UINT>(lod.first_index), 0);
+			continue;
+		}
+
+		// Только видимые и повёрнутые к камере кластеры, проверка в пространстве объекта
+		const Math_3d::Frustum objectFrustum(world * view * projection);
+		const Math_3d::Vector_3d objectCamera = Math_3d::transform_point(cameraPosition, Math_3d::inverse(world));
+		Geometry::cull_meshlets(*it.first, lod.first_meshlet, lod.meshlets_number, objectFrustum, objectCamera, drawRanges);
+		for (const Geometry::Draw_Range& range : drawRanges)
+		{
+			immediateContext->DrawIndexed(range.indices_number, range.first_index, 0);
+		}
 	}
 
 	//
@@ -433,6 +533,9 @@ void DX_11::setGeometry(shared_ptr<Geometry::Geometry> _geometry)
 
 		gpuData->size = objData->size;
 		gpuData->color = objData->color;
+		gpuData->format = objData->format;
+		gpuData->stride = objData->format == Geometry::Vertex_Format::full ?
+			sizeof(Geometry::Vertex) : sizeof(Geometry::Compact_Vertex);
 
 		// object shell
 		//object_def.push_back(objData->def.a);
@@ -449,23 +552,27 @@ void DX_11::setGeometry(shared_ptr<Geometry::Geometry> _geometry)
 
 		// Создание вершинного буфера
 		bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
-		bufferDesc.ByteWidth = sizeof(Geometry::Vertex) * objData->vertices.size();
+		bufferDesc.ByteWidth = gpuData->stride * objData->vertices.size();
 		bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 		bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 		bufferDesc.MiscFlags = 0;
 
-		InitData.pSysMem = &objData->vertices[0];
+		if (gpuData->format == Geometry::Vertex_Format::full)
+			InitData.pSysMem = &objData->vertices[0];
+		else
+			InitData.pSysMem = &objData->compact_vertices[0];
 		if (d3dDevice->CreateBuffer(&bufferDesc, &InitData, &gpuData->vertexBuffer) < 0)
 			return;
 
 		// Создание индексного буфера
 		bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
-		bufferDesc.ByteWidth = sizeof(DWORD) * objData->indices.size();
+		gpuData->indexFormat = objData->indices.is_wide() ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
+		bufferDesc.ByteWidth = objData->indices.get_bytes();
 		bufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
 		bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 		bufferDesc.MiscFlags = 0;
 
-		InitData.pSysMem = &objData->indices[0];
+		InitData.pSysMem = objData->indices.data();
 		if (d3dDevice->CreateBuffer(&bufferDesc, &InitData, &gpuData->indexBuffer) < 0)
 			return;
 	}
@@ -474,7 +581,6 @@ void DX_11::setGeometry(shared_ptr<Geometry::Geometry> _geometry)
 	immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	// Установка матриц
-	mWorld = XMMatrixIdentity();
 }
 
 void DX_11::updateGeometry()
@@ -483,7 +589,10 @@ void DX_11::updateGeometry()
 	{
 		D3D11_MAPPED_SUBRESOURCE resource;
 		immediateContext->Map(it.second->vertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &resource);
-		memcpy(resource.pData, &it.first->vertices[0], it.first->vertices.size() * sizeof(Geometry::Vertex));
+		if (it.second->format == Geometry::Vertex_Format::full)
+			memcpy(resource.pData, &it.first->vertices[0], it.first->vertices.size() * sizeof(Geometry::Vertex));
+		else
+			memcpy(resource.pData, &it.first->compact_vertices[0], it.first->compact_vertices.size() * sizeof(Geometry::Compact_Vertex));
 		immediateContext->Unmap(it.second->vertexBuffer, 0);
 	}
 }
@@ -13,6 +13,8 @@
 
 #include "camera.h"
 #include "geometry.h"
+#include "lod.h"
+#include "meshlets.h"
 
 using std::vector;
 using std::wstring;
@@ -27,11 +29,10 @@ class DX_11
 	//--------------------------------------------------------------------------------------
 	struct ConstantBuffer
 	{
-		XMMATRIX mWorld;//0
-		XMMATRIX mView;//64
-		XMMATRIX mProjection;//128
-		XMFLOAT4 light_color;//144
-		XMFLOAT4 light_pos;//160
+		XMMATRIX mView;//0
+		XMMATRIX mProjection;//64
+		XMFLOAT4 light_color;//128
+		XMFLOAT4 light_pos;//144
 		//XMFLOAT4 plane_def[80];//1120
 		//XMFLOAT4 plane_color[80];//2080
 		//XMFLOAT4 plane_num;//2096 num, curr_obj, tmp_1, tmp_2
@@ -39,21 +40,29 @@ class DX_11
 
 	struct ConstantBuffer_2
 	{
+		XMMATRIX mWorld;//obj transform
+		XMMATRIX mWorldNormal;//inverse transpose for normals
 		XMFLOAT4 color;//obj color
+		XMFLOAT4 bounds_offset;//compact vertex decode
+		XMFLOAT4 bounds_scale;
 		//XMFLOAT4 plane_num;//2096 num, curr_obj, tmp_1, tmp_2
 	};
 
 	struct Shader
 	{
 		ID3D11VertexShader* vertexShader = nullptr;
+		ID3D11VertexShader* vertexShader_compact = nullptr;
 		ID3D11PixelShader*  pixelShader = nullptr;
 	};
 
 	struct GPUData
 	{
 		int           size;
+		Geometry::Vertex_Format format = Geometry::Vertex_Format::full;
+		UINT          stride = sizeof(Geometry::Vertex);
 		ID3D11Buffer* vertexBuffer = nullptr;
 		ID3D11Buffer* indexBuffer = nullptr;
+		DXGI_FORMAT   indexFormat = DXGI_FORMAT_R32_UINT;
 		Math_3d::Vector_4d color;
 	};
 
@@ -73,6 +82,8 @@ class DX_11
 	ID3D11DepthStencilView* depthStencilView = nullptr;
 
 	ID3D11InputLayout*      vertexLayout = nullptr;
+	ID3D11InputLayout*      vertexLayout_half = nullptr;
+	ID3D11InputLayout*      vertexLayout_fixed = nullptr;
 
 	ID3D11Buffer*           constantBuffer = nullptr;
 	ID3D11Buffer*           constantBuffer_2 = nullptr;
@@ -96,9 +107,10 @@ class DX_11
 
 	Shader* shader;
 
-	XMMATRIX                mWorld;
-
 	vector<pair<Geometry::Object_Data*, GPUData*>>           objects;
+	vector<Geometry::Draw_Range>                             drawRanges;
+	Math_3d::Box_Batch                                       objectBoxes;
+	vector<uint32_t>                                         visibleObjects;
 
 	//vector<Vector4> object_def;
 	//vector<Vector4> object_color;
@@ -121,5 +133,7 @@ public:
 
 	void setCamera(std::shared_ptr<Camera> _camera);
 
+	// Загрузка вершин после изменения сетки, перемещение
+	// объектов меняет только Object_Data::transform
 	void updateGeometry();
 };
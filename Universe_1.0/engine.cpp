@@ -56,7 +56,6 @@ void Engine::render()
 	{
 		if (render_ctrl)
 		{
-			device->updateGeometry();
 			device->render();
 		}
 	}
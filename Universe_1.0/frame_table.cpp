@@ -0,0 +1,136 @@
+/******************************************************************************
+	 * File: frame_table.cpp
+	 * Description: Contains rotation minimizing frames of paths.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include "frame_table.h"
+#include "geometry.h"
+
+namespace Geometry
+{
+	namespace
+	{
+		Math_3d::Vector_3d unit_tangent(const Path& path, float t, float path_delta)
+		{
+			Math_3d::Vector_3d tangent = path.get_tangent(t);
+			// Tangent vanishes where control points repeat, use chord then
+			if ((tangent & tangent) == 0.0f)
+			{
+				tangent = path.get_point(t + path_delta) - path.get_point(t - path_delta);
+			}
+			return Math_3d::normalized<Precision>(tangent);
+		}
+
+		/**
+		 * vec reflected by plane of normal axis, axis_sq = axis & axis
+		 */
+		Math_3d::Vector_3d reflect_vector(Math_3d::Vector_3d vec, Math_3d::Vector_3d axis, float axis_sq)
+		{
+			return vec - axis * (2.0f * (axis & vec) / axis_sq);
+		}
+
+		/**
+		 * Unit vector orthogonal to unit tangent, from axis least aligned with it
+		 */
+		Math_3d::Vector_3d get_any_normal(Math_3d::Vector_3d tangent)
+		{
+			float x = fabsf(tangent.x);
+			float y = fabsf(tangent.y);
+			float z = fabsf(tangent.z);
+			Math_3d::Vector_3d axis = x <= y && x <= z ? Math_3d::Vector_3d(1.0f, 0.0f, 0.0f)
+									: (y <= z ? Math_3d::Vector_3d(0.0f, 1.0f, 0.0f) : Math_3d::Vector_3d(0.0f, 0.0f, 1.0f));
+			return Math_3d::normalized<Precision>(axis - tangent * (axis & tangent));
+		}
+	}
+
+	Math_3d::Vector_3d Frame::get_normal(float cos_angle, float sin_angle) const
+	{
+		return normal * cos_angle + binormal * sin_angle;
+	}
+
+	Frame_Table::Frame_Table(const Path& path, size_t segments, float path_delta)
+	: path_delta(path_delta)
+	{
+		if (segments == 0)
+		{
+			segments = 1;
+		}
+		points.resize(segments + 1);
+		frames.resize(segments + 1);
+
+		for (size_t i = 0; i <= segments; ++i)
+		{
+			float t = static_cast<float>(i) / static_cast<float>(segments);
+			points[i] = path.get_point(t);
+			frames[i].tangent = unit_tangent(path, t, path_delta);
+		}
+
+		frames[0].normal = get_any_normal(frames[0].tangent);
+		frames[0].binormal = frames[0].tangent ^ frames[0].normal;
+		for (size_t i = 0; i < segments; ++i)
+		{
+			frames[i + 1] = reflect(frames[i], points[i], points[i + 1], frames[i + 1].tangent);
+		}
+	}
+
+	Frame Frame_Table::reflect(const Frame& frame, Math_3d::Vector_3d point, Math_3d::Vector_3d next_point,
+							   Math_3d::Vector_3d next_tangent) const
+	{
+		// First reflection maps point to next_point, second one aligns tangents
+		Math_3d::Vector_3d normal = frame.normal;
+		Math_3d::Vector_3d tangent = frame.tangent;
+		Math_3d::Vector_3d v1 = next_point - point;
+		float c1 = v1 & v1;
+		if (c1 > 0.0f)
+		{
+			normal = reflect_vector(normal, v1, c1);
+			tangent = reflect_vector(tangent, v1, c1);
+		}
+		Math_3d::Vector_3d v2 = next_tangent - tangent;
+		float c2 = v2 & v2;
+		if (c2 > 0.0f)
+		{
+			normal = reflect_vector(normal, v2, c2);
+		}
+
+		// Keep frame orthonormal against float drift
+		Frame result;
+		result.tangent = next_tangent;
+		result.normal = Math_3d::normalized<Precision>(normal - next_tangent * (normal & next_tangent));
+		result.binormal = next_tangent ^ result.normal;
+		return result;
+	}
+
+	size_t Frame_Table::get_segments_number() const
+	{
+		return frames.empty() ? 0 : frames.size() - 1;
+	}
+
+	Frame Frame_Table::get_frame(const Path& path, float t) const
+	{
+		return get_frame(t, path.get_point(t), unit_tangent(path, t, path_delta));
+	}
+
+	Frame Frame_Table::get_frame(float t, Math_3d::Vector_3d point, Math_3d::Vector_3d unit_tangent) const
+	{
+		const size_t segments = get_segments_number();
+		if (segments == 0)
+		{
+			Frame frame;
+			frame.tangent = unit_tangent;
+			frame.normal = get_any_normal(unit_tangent);
+			frame.binormal = unit_tangent ^ frame.normal;
+			return frame;
+		}
+
+		float x = t * static_cast<float>(segments);
+		size_t i = x <= 0.0f ? 0 : static_cast<size_t>(x);
+		i = i < segments ? i : segments - 1;
+		return reflect(frames[i], points[i], point, unit_tangent);
+	}
+}
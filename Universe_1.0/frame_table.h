@@ -0,0 +1,71 @@
+/******************************************************************************
+	 * File: frame_table.h
+	 * Description: Contains rotation minimizing frames of paths.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <vector>
+
+#include "math_3d.h"
+
+namespace Geometry
+{
+	class Path;
+
+	/**
+	* @struct Frame
+	* Orthonormal frame of path point, binormal = tangent ^ normal
+	*/
+	struct Frame
+	{
+		Math_3d::Vector_3d tangent;
+		Math_3d::Vector_3d normal;
+		Math_3d::Vector_3d binormal;
+
+		/**
+		 * normal rotated around tangent by angle of given cos and sin
+		 */
+		Math_3d::Vector_3d get_normal(float cos_angle, float sin_angle) const;
+	};
+
+	/**
+	* @class Frame_Table
+	* Rotation minimizing frames of path (double reflection method,
+	* Wang et al. 2008) at segments + 1 evenly spaced t.
+	* Frame at any t is one more reflection step from the table entry
+	* below it, so queries are independent and can run in parallel.
+	* Table does not depend on sweep start, frames of other start normal
+	* are the same ones rotated by constant angle around tangent.
+	*/
+	class Frame_Table
+	{
+		std::vector<Math_3d::Vector_3d> points;
+		std::vector<Frame> frames;
+		float path_delta = 0.01f;
+
+		Frame reflect(const Frame& frame, Math_3d::Vector_3d point, Math_3d::Vector_3d next_point,
+					  Math_3d::Vector_3d next_tangent) const;
+
+	public:
+		static const size_t default_segments = 256;
+
+		Frame_Table() {};
+		/**
+		 * Vanished tangents are replaced by chord of +-path_delta
+		 */
+		explicit Frame_Table(const Path& path, size_t segments = default_segments, float path_delta = 0.01f);
+
+		size_t get_segments_number() const;
+		/**
+		 * Frame at t, point is path point at t
+		 */
+		Frame get_frame(const Path& path, float t) const;
+		Frame get_frame(float t, Math_3d::Vector_3d point, Math_3d::Vector_3d unit_tangent) const;
+	};
+}
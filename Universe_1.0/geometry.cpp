@@ -8,22 +8,241 @@
 
 ******************************************************************************/
 
+#include <algorithm>
+#include <map>
+#include <utility>
+
 #include "geometry.h"
+#include "math_3d_expr.h"
+#include "lod.h"
+#include "meshlets.h"
+#include "normals.h"
+#include "thread_pool.h"
 
 namespace Geometry
 {
+	namespace
+	{
+		// Corners of "square" profile, computed by compiler
+		constexpr Math_3d::Expr::Unit_Circle<4> square_corners;
+
+		/**
+		 * Distance from point to line through chord_a and chord_b,
+		 * to chord_a if chord is degenerate
+		 */
+		float distance_to_chord(Math_3d::Vector_3d point, Math_3d::Vector_3d chord_a, Math_3d::Vector_3d chord_b)
+		{
+			Math_3d::Vector_3d chord = chord_b - chord_a;
+			Math_3d::Vector_3d offset = point - chord_a;
+			float chord_length_sq = chord & chord;
+			if (chord_length_sq == 0.0f)
+			{
+				return sqrtf(offset & offset);
+			}
+			Math_3d::Vector_3d normal = offset ^ chord;
+			return sqrtf((normal & normal) / chord_length_sq);
+		}
+
+		using Point_2d = std::pair<float, float>;
+
+		float cross(const Point_2d& a, const Point_2d& b, const Point_2d& c)
+		{
+			return (b.first - a.first) * (c.second - a.second) - (b.second - a.second) * (c.first - a.first);
+		}
+
+		/**
+		 * Triangles of simple polygon, counter-clockwise whatever its order.
+		 * Convex one is fanned from corner which gives fewest degenerate
+		 * triangles, concave one is ear clipped.
+		 */
+		std::vector<int> triangulate_polygon(const std::vector<Point_2d>& points)
+		{
+			std::vector<int> triangles;
+			const int n = points.size();
+			if (n < 3)
+			{
+				return triangles;
+			}
+			triangles.reserve((n - 2) * 3);
+
+			float area = 0.0f;
+			for (int i = 0; i < n; ++i)
+			{
+				const Point_2d& a = points[i];
+				const Point_2d& b = points[(i + 1) % n];
+				area += a.first * b.second - b.first * a.second;
+			}
+			std::vector<int> order(n);
+			for (int i = 0; i < n; ++i)
+			{
+				order[i] = area < 0.0f ? n - 1 - i : i;
+			}
+
+			bool convex = true;
+			for (int i = 0; i < n && convex; ++i)
+			{
+				convex = cross(points[order[i]], points[order[(i + 1) % n]], points[order[(i + 2) % n]]) >= 0.0f;
+			}
+
+			if (convex)
+			{
+				// Collinear points give degenerate triangles
+				// when fanned from a point on their line
+				int apex = 0;
+				int apex_degenerate = n;
+				for (int i = 0; i < n && apex_degenerate > 0; ++i)
+				{
+					int degenerate = 0;
+					for (int j = 1; j + 1 < n; ++j)
+					{
+						const Point_2d& b = points[order[(i + j) % n]];
+						const Point_2d& c = points[order[(i + j + 1) % n]];
+						degenerate += cross(points[order[i]], b, c) == 0.0f ? 1 : 0;
+					}
+					if (degenerate < apex_degenerate)
+					{
+						apex = i;
+						apex_degenerate = degenerate;
+					}
+				}
+				for (int j = 1; j + 1 < n; ++j)
+				{
+					triangles.push_back(order[apex]);
+					triangles.push_back(order[(apex + j) % n]);
+					triangles.push_back(order[(apex + j + 1) % n]);
+				}
+				return triangles;
+			}
+
+			// Ear clipping, O(n^2)
+			while (order.size() > 3)
+			{
+				const int size = order.size();
+				int ear = -1;
+				float best_cross = -1.0f;
+				for (int i = 0; i < size && ear < 0; ++i)
+				{
+					const Point_2d& a = points[order[(i + size - 1) % size]];
+					const Point_2d& b = points[order[i]];
+					const Point_2d& c = points[order[(i + 1) % size]];
+					float corner = cross(a, b, c);
+					if (corner <= 0.0f)
+					{
+						continue;
+					}
+					// Fallback for degenerate input: largest convex corner
+					if (corner > best_cross)
+					{
+						best_cross = corner;
+					}
+
+					bool empty = true;
+					for (int j = 0; j < size && empty; ++j)
+					{
+						if (j == i || j == (i + size - 1) % size || j == (i + 1) % size)
+						{
+							continue;
+						}
+						const Point_2d& p = points[order[j]];
+						empty = !(cross(a, b, p) >= 0.0f && cross(b, c, p) >= 0.0f && cross(c, a, p) >= 0.0f);
+					}
+					if (empty)
+					{
+						ear = i;
+					}
+				}
+				if (ear < 0)
+				{
+					// No ear in self-touching or collinear polygon, cut any corner
+					ear = 0;
+					for (int i = 0; i < size; ++i)
+					{
+						if (cross(points[order[(i + size - 1) % size]], points[order[i]], points[order[(i + 1) % size]]) == best_cross)
+						{
+							ear = i;
+							break;
+						}
+					}
+				}
+				triangles.push_back(order[(ear + size - 1) % size]);
+				triangles.push_back(order[ear]);
+				triangles.push_back(order[(ear + 1) % size]);
+				order.erase(order.begin() + ear);
+			}
+			triangles.push_back(order[0]);
+			triangles.push_back(order[1]);
+			triangles.push_back(order[2]);
+			return triangles;
+		}
+
+		/**
+		 * Unit tangent, zero stays zero
+		 */
+		Math_3d::Vector_3d unit_tangent(const Path& path, float t)
+		{
+			Math_3d::Vector_3d tangent = path.get_tangent(t);
+			if ((tangent & tangent) == 0.0f)
+			{
+				return tangent;
+			}
+			return Math_3d::normalized<Precision>(tangent);
+		}
+	}
+
 	int Object::obj_counter = 0;
 	std::vector<Object*> objects;
 
+	void Object_Data::set_vertex_format(Vertex_Format vertex_format)
+	{
+		format = vertex_format;
+		if (format == Vertex_Format::full)
+		{
+			compact_vertices.clear();
+			compact_vertices.shrink_to_fit();
+			bounds = Vertex_Bounds();
+			return;
+		}
+		bounds = get_vertex_bounds(vertices.data(), vertices.size(), format);
+		compact_vertices.resize(vertices.size());
+		encode_vertices(vertices.data(), vertices.size(), format, bounds, compact_vertices.data());
+	}
+
+	void Object_Data::update_bounds()
+	{
+		mesh_bounds = Mesh_Bounds();
+		if (vertices.empty())
+		{
+			return;
+		}
+		Math_3d::Vector_3d low = vertices.front().pos;
+		Math_3d::Vector_3d high = low;
+		for (const Vertex& vertex : vertices)
+		{
+			low = Math_3d::Vector_3d(fminf(low.x, vertex.pos.x), fminf(low.y, vertex.pos.y), fminf(low.z, vertex.pos.z));
+			high = Math_3d::Vector_3d(fmaxf(high.x, vertex.pos.x), fmaxf(high.y, vertex.pos.y), fmaxf(high.z, vertex.pos.z));
+		}
+		mesh_bounds.low = low;
+		mesh_bounds.high = high;
+		mesh_bounds.center = (low + high) * 0.5f;
+
+		float radius_sq = 0.0f;
+		for (const Vertex& vertex : vertices)
+		{
+			const Math_3d::Vector_3d offset = vertex.pos - mesh_bounds.center;
+			radius_sq = fmaxf(radius_sq, offset & offset);
+		}
+		mesh_bounds.radius = sqrtf(radius_sq);
+	}
+
 	Shape::Shape(std::string type, float size)
 	{
 		if (type == "square")
 		{
-			wrap = true;
-			data = { std::make_pair(size, 0.0f),
-					 std::make_pair(size, 90.0f),
-					 std::make_pair(size, 180.0f),
-					 std::make_pair(size, 270.0f) };
+			data.reserve(4);
+			for (int i = 0; i < 4; ++i)
+			{
+				data.push_back({ size, square_corners.cos_value[i], square_corners.sin_value[i] });
+			}
 		}
 		else if (type == "plane")
 		{
@@ -31,46 +250,131 @@ namespace Geometry
 			//  \   \   \   \  |  /   /   /   /
 			//                 *
 			//            start point
-			wrap = false;
 			int segments = 100;
 			float normal_size = 1.0f;
 			float step = 1.0f / static_cast<float>(segments);
 
-			Math_3d::Vector_3d start_point  = { 0.0f, 0.0f, 0.0f };
-			Math_3d::Vector_3d normal_vec   = { 0.0f, 1.0f * normal_size, 0.0f };
-			Math_3d::Vector_3d plane_vec    = { 1.0f, 0.0f, 0.0f };
-			Math_3d::Vector_3d center_point = start_point + normal_vec;
-
+			std::vector<std::pair<float, float>> points;
 			for (float t = -0.5f; t <= 0.5f; t += step)
 			{
-				float plane_length = static_cast<float>(abs(size * t));
-				Math_3d::Vector_3d plane_point = center_point + (size * t) * plane_vec;
-				Math_3d::Vector_3d bisector_vec = plane_point - start_point;
+				points.push_back(std::make_pair(normal_size, size * t));
+			}
+			*this = polyline(points, false);
+		}
+	}
 
-				float bisector_length = bisector_vec.length();
-				float bisector_angle = Math_3d::radian_to_degree(Math_3d::angle(bisector_vec, normal_vec));
-				if (t < 0.0f)
-				{
-					bisector_angle *= -1.0f;
-				}
-				data.push_back(std::make_pair(bisector_length, bisector_angle));
+	Shape Shape::circle(int segments, float radius)
+	{
+		Shape shape;
+		std::shared_ptr<const Unit_Circle> unit_circle = get_unit_circle(segments);
+		shape.data.reserve(unit_circle->size());
+		for (const auto& offset : *unit_circle)
+		{
+			shape.data.push_back({ radius, offset.first, offset.second });
+		}
+		return shape;
+	}
+
+	Shape Shape::polyline(const std::vector<std::pair<float, float>>& points, bool wrap)
+	{
+		Shape shape;
+		shape.wrap = wrap;
+		shape.data.reserve(points.size());
+		for (const auto& point : points)
+		{
+			float length = sqrtf(point.first * point.first + point.second * point.second);
+			if (length == 0.0f)
+			{
+				shape.data.push_back({ 0.0f, 1.0f, 0.0f });
+				continue;
+			}
+			shape.data.push_back({ length, point.first / length, point.second / length });
+		}
+		return shape;
+	}
+
+	Shape Shape::spline(const std::vector<std::pair<float, float>>& points, int segments, bool wrap,
+						Math_3d::Spline::Type type)
+	{
+		std::vector<Math_3d::Vector_3d> control_points;
+		const size_t n = points.size();
+		if (n < 2 || segments < 1)
+		{
+			return polyline(points, wrap);
+		}
+
+		float t0 = 0.0f;
+		float t1 = 1.0f;
+		size_t count = segments + 1;
+		if (wrap && type != Math_3d::Spline::Type::cubic_bezier)
+		{
+			// Segments 1 .. n of last, all, first, second points
+			// have cyclic neighbours, sample them without repeated end
+			control_points.push_back(Math_3d::Vector_3d(points[n - 1].first, points[n - 1].second, 0.0f));
+			for (size_t i = 0; i < n + 2; ++i)
+			{
+				const auto& point = points[i % n];
+				control_points.push_back(Math_3d::Vector_3d(point.first, point.second, 0.0f));
+			}
+			float segments_number = static_cast<float>(n + 2);
+			t0 = 1.0f / segments_number;
+			t1 = static_cast<float>(n + 1) / segments_number;
+			count = segments;
+		}
+		else
+		{
+			for (const auto& point : points)
+			{
+				control_points.push_back(Math_3d::Vector_3d(point.first, point.second, 0.0f));
+			}
+		}
+
+		Math_3d::Spline curve(control_points, type);
+		std::vector<Math_3d::Vector_3d> samples(segments + 1);
+		curve.sample(t0, t1, segments + 1, samples.data());
+
+		std::vector<std::pair<float, float>> profile(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			profile[i] = std::make_pair(samples[i].x, samples[i].y);
+		}
+		return polyline(profile, wrap);
+	}
+
+	std::shared_ptr<const Shape::Unit_Circle> Shape::get_unit_circle(int segments)
+	{
+		static std::mutex cache_mutex;
+		static std::map<int, std::shared_ptr<const Unit_Circle>> cache;
+
+		std::lock_guard<std::mutex> lock(cache_mutex);
+		std::shared_ptr<const Unit_Circle>& unit_circle = cache[segments];
+		if (unit_circle == nullptr)
+		{
+			const double pi = 3.14159265358979323846;
+			auto table = std::make_shared<Unit_Circle>(segments > 0 ? segments : 0);
+			for (int i = 0; i < segments; ++i)
+			{
+				double angle = 2.0 * pi * static_cast<double>(i) / static_cast<double>(segments);
+				(*table)[i] = std::make_pair(static_cast<float>(cos(angle)), static_cast<float>(sin(angle)));
 			}
+			unit_circle = table;
 		}
+		return unit_circle;
 	}
 
-	std::vector<std::pair<float, float>>::iterator Shape::begin()
+	std::vector<Profile_Point>::iterator Shape::begin()
 	{
 		return data.begin();
 	}
-	std::vector<std::pair<float, float>>::iterator Shape::end()
+	std::vector<Profile_Point>::iterator Shape::end()
 	{
 		return data.end();
 	}
-	std::vector<std::pair<float, float>>::const_iterator Shape::begin() const
+	std::vector<Profile_Point>::const_iterator Shape::begin() const
 	{
 		return data.cbegin();
 	}
-	std::vector<std::pair<float, float>>::const_iterator Shape::end() const
+	std::vector<Profile_Point>::const_iterator Shape::end() const
 	{
 		return data.cend();
 	}
@@ -85,23 +389,157 @@ namespace Geometry
 		return wrap ? data.size() : data.size() - 1;
 	}
 
-	Path::Path(std::vector<Math_3d::Vector_3d> control_points)
-	: control_points(control_points) {}
+	std::vector<int> Shape::triangulate() const
+	{
+		return triangulate_polygon(get_polygon());
+	}
 
-	Math_3d::Vector_3d Path::get_point(float t) const
+	float Shape::get_area() const
 	{
-		Math_3d::Vector_3d result;
-		int n = control_points.size() - 1;
+		std::vector<Point_2d> polygon = get_polygon();
+		float area = 0.0f;
+		for (size_t i = 0; i < polygon.size(); ++i)
+		{
+			const Point_2d& a = polygon[i];
+			const Point_2d& b = polygon[(i + 1) % polygon.size()];
+			area += a.first * b.second - b.first * a.second;
+		}
+		return 0.5f * area;
+	}
 
-		for (int i = 0; i < control_points.size(); ++i)
+	Shape Shape::coarsen(int factor) const
+	{
+		const int min_points = wrap ? 3 : 2;
+		if (factor <= 1 || (size() + factor - 1) / factor < min_points)
+		{
+			return *this;
+		}
+		Shape shape;
+		shape.wrap = wrap;
+		for (int i = 0; i < size(); i += factor)
 		{
-			float binom_factorial = Math_3d::factorial(n) / (Math_3d::factorial(i) * Math_3d::factorial(n - i));
-			float bernstein_polynom = binom_factorial * pow(t, i) * pow(1.0f - t, n - i);
+			shape.data.push_back(data[i]);
+		}
+		if (!wrap && (size() - 1) % factor != 0)
+		{
+			shape.data.push_back(data.back());
+		}
+		return shape;
+	}
+
+	std::vector<std::pair<float, float>> Shape::get_polygon() const
+	{
+		std::vector<Point_2d> polygon;
+		polygon.reserve(data.size() + 1);
+		for (const Profile_Point& point : data)
+		{
+			polygon.push_back(std::make_pair(point.length * point.cos_angle, point.length * point.sin_angle));
+		}
+		if (!wrap)
+		{
+			polygon.push_back(std::make_pair(0.0f, 0.0f));
+		}
+		return polygon;
+	}
+
+	void Path::sample(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const
+	{
+		float delta = count > 1 ? (t1 - t0) / static_cast<float>(count - 1) : 0.0f;
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = get_point(t0 + delta * static_cast<float>(i));
+		}
+	}
+
+	void Path::sample_tangents(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const
+	{
+		float delta = count > 1 ? (t1 - t0) / static_cast<float>(count - 1) : 0.0f;
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = get_tangent(t0 + delta * static_cast<float>(i));
+		}
+	}
+
+	const Arc_Length_Table& Path::get_arc_length() const
+	{
+		std::call_once(arc_length_flag, [this]() { arc_length = Arc_Length_Table(*this); });
+		return arc_length;
+	}
+
+	const Frame_Table& Path::get_frames() const
+	{
+		std::call_once(frames_flag, [this]() { frames = Frame_Table(*this); });
+		return frames;
+	}
 
-			result += control_points[i] * bernstein_polynom;
+	Math_3d::Vector_3d Path::get_point_at_distance(float distance) const
+	{
+		return get_point(get_arc_length().get_parameter(distance));
+	}
+
+	void Path::sample_at_distances(const float* distances, size_t count, Math_3d::Vector_3d* out) const
+	{
+		const Arc_Length_Table& table = get_arc_length();
+		// Parameters of a chunk at a time, no allocation per call
+		const size_t chunk = 256;
+		float params[chunk];
+		for (size_t first = 0; first < count; first += chunk)
+		{
+			size_t chunk_count = count - first < chunk ? count - first : chunk;
+			table.get_parameters(distances + first, chunk_count, params);
+			for (size_t i = 0; i < chunk_count; ++i)
+			{
+				out[first + i] = get_point(params[i]);
+			}
 		}
+	}
+
+
+	Bezier_Path::Bezier_Path(std::vector<Math_3d::Vector_3d> control_points)
+	: curve(control_points) {}
+
+	Math_3d::Vector_3d Bezier_Path::get_point(float t) const
+	{
+		return curve.get_point(t);
+	}
+
+	Math_3d::Vector_3d Bezier_Path::get_tangent(float t) const
+	{
+		return curve.get_tangent(t);
+	}
+
+	void Bezier_Path::sample(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const
+	{
+		curve.sample(t0, t1, count, out);
+	}
 
-		return result;
+	void Bezier_Path::sample_tangents(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const
+	{
+		curve.sample_tangents(t0, t1, count, out);
+	}
+
+
+	Spline_Path::Spline_Path(std::vector<Math_3d::Vector_3d> control_points, Math_3d::Spline::Type type)
+	: curve(control_points, type) {}
+
+	Math_3d::Vector_3d Spline_Path::get_point(float t) const
+	{
+		return curve.get_point(t);
+	}
+
+	Math_3d::Vector_3d Spline_Path::get_tangent(float t) const
+	{
+		return curve.get_tangent(t);
+	}
+
+	void Spline_Path::sample(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const
+	{
+		curve.sample(t0, t1, count, out);
+	}
+
+	void Spline_Path::sample_tangents(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const
+	{
+		curve.sample_tangents(t0, t1, count, out);
 	}
 
 	Generator::Generator() {}
@@ -109,56 +547,242 @@ namespace Geometry
 	Generator::Generator(std::unique_ptr<Path> path, std::unique_ptr<Shape> shape, Math_3d::Vector_3d base_vec)
 	: path(std::move(path)), shape(std::move(shape)), base_vec(base_vec) {}
 
-	void Generator::make_mesh(Object_Data& data)
+	void Generator::set_tessellation(Tessellation tessellation, float chord_tolerance, float angle_tolerance)
 	{
-		int object_first_index = data.vertices.size();
+		this->tessellation = tessellation;
+		this->chord_tolerance = chord_tolerance;
+		this->angle_tolerance = angle_tolerance;
+	}
 
-		// Go through slices and apply shape to them
-		for (float t = 0.0f; t < 1.0f; t += step)
+	void Generator::set_cap(Cap cap, int split_points)
+	{
+		this->cap = cap;
+		this->split_points = split_points;
+		sector_step = 1.0f / static_cast<float>(split_points + 1);
+	}
+
+	std::vector<float> Generator::get_slices() const
+	{
+		std::vector<float> slices;
+		if (tessellation == Tessellation::fixed)
 		{
-			int start_index = data.vertices.size();
-			Math_3d::Vector_3d center = path->get_point(t);
+			// Equal intervals no longer than step, slack keeps 1 / 0.02f at 50
+			const int intervals = step > 0.0f ? std::max(static_cast<int>(ceilf(1.0f / step - 1e-4f)), 1) : 1;
+			slices.reserve(intervals + 1);
+			for (int slice = 0; slice < intervals; ++slice)
+			{
+				slices.push_back(static_cast<float>(slice) / static_cast<float>(intervals));
+			}
+			slices.push_back(1.0f);
+			return slices;
+		}
+
+		const float min_cos = cosf(Math_3d::degree_to_radian(angle_tolerance));
+		slices.push_back(0.0f);
+		subdivide(0.0f, 1.0f, 0, min_cos, slices);
+		return slices;
+	}
 
-			Math_3d::Vector_3d path_vec = (path->get_point(t + path_delta) - center).normalize();
-			base_vec = Math_3d::project_vector_to_plane(base_vec, center, path_vec).normalize();
-			for (auto item : *shape)
+	void Generator::subdivide(float t0, float t1, int depth, float min_cos, std::vector<float>& slices) const
+	{
+		const float t_mid = 0.5f * (t0 + t1);
+		bool split = false;
+		if (depth < max_depth)
+		{
+			// Bend: tangents at ends and middle, vanished tangent is skipped
+			Math_3d::Vector_3d tangent_0 = unit_tangent(*path, t0);
+			Math_3d::Vector_3d tangent_mid = unit_tangent(*path, t_mid);
+			Math_3d::Vector_3d tangent_1 = unit_tangent(*path, t1);
+			auto bent = [min_cos](Math_3d::Vector_3d tangent_a, Math_3d::Vector_3d tangent_b) -> bool
 			{
-				Vertex vertex;
-				const float length = item.first;
-				const float angle = item.second;
+				return (tangent_a & tangent_a) != 0.0f && (tangent_b & tangent_b) != 0.0f && (tangent_a & tangent_b) < min_cos;
+			};
+			split = bent(tangent_0, tangent_mid) || bent(tangent_mid, tangent_1);
+
+			// Chord error: quarters too, middle alone lies on chord of S-curve
+			Math_3d::Vector_3d point_0 = path->get_point(t0);
+			Math_3d::Vector_3d point_1 = path->get_point(t1);
+			for (int quarter = 1; quarter < 4 && !split; ++quarter)
+			{
+				float t = t0 + (t1 - t0) * 0.25f * static_cast<float>(quarter);
+				split = distance_to_chord(path->get_point(t), point_0, point_1) > chord_tolerance;
+			}
+		}
+
+		if (split)
+		{
+			subdivide(t0, t_mid, depth + 1, min_cos, slices);
+			subdivide(t_mid, t1, depth + 1, min_cos, slices);
+		}
+		else
+		{
+			slices.push_back(t1);
+		}
+	}
+
+	Mesh_Size Generator::plan_mesh() const
+	{
+		return plan_mesh(get_slices().size());
+	}
 
-				vertex.pos = center + (Math_3d::rotate_vector(base_vec, path_vec, angle).normalize() * length);
-				// vertex.normal = (vertex.pos - center).normalize();
-				data.vertices.push_back(vertex);
+	Mesh_Size Generator::plan_mesh(size_t slices) const
+	{
+		const size_t shape_size = shape->size();
+		const size_t edges_number = shape->get_edges_number();
+
+		Mesh_Size size;
+		size.vertices = slices * shape_size;
+		size.indices = (slices > 0 ? slices - 1 : 0) * edges_number * 6;
+		if (cap == Cap::triangulated)
+		{
+			// Ring of profile points, path point closes open profile
+			const size_t cap_size = shape_size + (shape_size == edges_number ? 0 : 1);
+			size.vertices += 2 * cap_size;
+			size.indices += cap_size >= 3 ? 2 * (cap_size - 2) * 3 : 0;
+		}
+		else if (cap == Cap::subdivided)
+		{
+			// Per cap sector: triangle rows of split_points + 2, ..., 1 vertices
+			// and (split_points + 1)^2 triangles
+			const size_t rows = split_points + 2;
+			const size_t sector_vertices = rows * (rows + 1) / 2;
+			const size_t sector_indices = (split_points + 1) * (split_points + 1) * 3;
+			size.vertices += 2 + 2 * shape_size * sector_vertices;
+			size.indices += 2 * shape_size * sector_indices;
+		}
+		return size;
+	}
+
+	void Generator::make_mesh(Object_Data& data)
+	{
+		int object_first_index = data.vertices.size();
+
+		const std::vector<float> slice_params = get_slices();
+		const int slices = slice_params.size();
+		const Mesh_Size size = plan_mesh(slices);
+		data.vertices.reserve(data.vertices.size() + size.vertices);
+		data.indices.set_vertex_count(data.vertices.size() + size.vertices);
+		data.indices.reserve(data.indices.size() + size.indices);
+
+		// Evaluate whole path at once, evenly spaced slices are sampled
+		std::vector<Math_3d::Vector_3d> centers(slices);
+		std::vector<Math_3d::Vector_3d> tangents(slices);
+		if (tessellation == Tessellation::fixed)
+		{
+			path->sample(0.0f, slice_params.back(), slices, centers.data());
+			path->sample_tangents(0.0f, slice_params.back(), slices, tangents.data());
+		}
+		else
+		{
+			for (int slice = 0; slice < slices; ++slice)
+			{
+				centers[slice] = path->get_point(slice_params[slice]);
+				tangents[slice] = path->get_tangent(slice_params[slice]);
 			}
+		}
+		for (int slice = 0; slice < slices; ++slice)
+		{
+			// Tangent vanishes where control points repeat, use chord then
+			if ((tangents[slice] & tangents[slice]) == 0.0f)
+			{
+				float t = slice_params[slice];
+				tangents[slice] = path->get_point(t + path_delta) - path->get_point(t - path_delta);
+			}
+			tangents[slice].normalize();
+		}
+
+		// Slice frames are rotation minimizing frames of path
+		// turned around tangent so that first one starts at base_vec
+		const Frame_Table& frame_table = path->get_frames();
+		const Frame first_frame = frame_table.get_frame(slice_params.front(), centers.front(), tangents.front());
+		Math_3d::Vector_3d start_vec = Math_3d::project_vector_to_plane(base_vec, centers.front(), first_frame.tangent);
+		float cos_angle = 1.0f;
+		float sin_angle = 0.0f;
+		if ((start_vec & start_vec) > 0.0f)
+		{
+			start_vec = Math_3d::normalized<Precision>(start_vec);
+			cos_angle = start_vec & first_frame.normal;
+			sin_angle = start_vec & first_frame.binormal;
+		}
+
+		// Each slice owns its range of vertices and indices
+		// (indices of quads between it and previous slice)
+		const int shape_size = shape->size();
+		const int edges_number = shape->get_edges_number();
+		const int slice_indices = edges_number * 6;
+		const int object_first_indices = data.indices.size();
+		data.vertices.resize(object_first_index + slices * shape_size);
+		data.indices.resize(object_first_indices + (slices - 1) * slice_indices);
 
-			// Set indices, not required for first
-			if (t > path_delta)
+		// Quads face outside, i.e. counter-clockwise, for counter-clockwise profile
+		const bool clockwise = shape->get_area() < 0.0f;
+
+		// Go through slices and apply shape to them
+		const Shape& slice_shape = *shape;
+		Thread_Pool::get_instance().parallel_for(0, slices, [&](size_t slice_begin, size_t slice_end)
+		{
+			for (int slice = static_cast<int>(slice_begin); slice < static_cast<int>(slice_end); ++slice)
 			{
-				for (int i = 0; i < shape->get_edges_number(); ++i)
+				int start_index = object_first_index + slice * shape_size;
+				Math_3d::Vector_3d center = centers[slice];
+				Math_3d::Vector_3d path_vec = tangents[slice];
+				Math_3d::Vector_3d slice_base_vec = frame_table.get_frame(slice_params[slice], center, path_vec).get_normal(cos_angle, sin_angle);
+				// base_vec rotated by 90 degrees around path
+				Math_3d::Vector_3d slice_side_vec = path_vec ^ slice_base_vec;
+
+				Vertex* vertex = &data.vertices[start_index];
+				for (const Profile_Point& point : slice_shape)
 				{
-					int p1_index = start_index - shape->size() + i;
-					int p2_index = start_index - shape->size() + (i + 1) % shape->size();
-					int p3_index = start_index + (i + 1) % shape->size();
-					int p4_index = start_index + i;
-
-					data.indices.push_back(p1_index);
-					data.indices.push_back(p2_index);
-					data.indices.push_back(p3_index);
-
-					data.indices.push_back(p1_index);
-					data.indices.push_back(p3_index);
-					data.indices.push_back(p4_index);
+					vertex->pos = center + (slice_base_vec * point.cos_angle + slice_side_vec * point.sin_angle) * point.length;
+					// vertex->normal = (vertex->pos - center).normalize();
+					++vertex;
+				}
+
+				// Set indices, not required for first
+				if (slice > 0)
+				{
+					size_t index = object_first_indices + (slice - 1) * slice_indices;
+					for (int i = 0; i < edges_number; ++i)
+					{
+						int p1_index = start_index - shape_size + i;
+						int p2_index = start_index - shape_size + (i + 1) % shape_size;
+						int p3_index = start_index + (i + 1) % shape_size;
+						int p4_index = start_index + i;
+						if (clockwise)
+						{
+							std::swap(p2_index, p4_index);
+						}
+
+						data.indices.set(index++, p1_index);
+						data.indices.set(index++, p2_index);
+						data.indices.set(index++, p3_index);
+
+						data.indices.set(index++, p1_index);
+						data.indices.set(index++, p3_index);
+						data.indices.set(index++, p4_index);
+					}
 				}
 			}
-		}
+		});
 		int object_last_index = data.vertices.size();
 
-		calc_normale(data, object_first_index);
+		// Edge length weights keep corners of coarse profiles symmetric
+		compute_normals(data, object_first_index, object_first_indices, Normal_Weight::edge_length);
 
-		if (!solid)
+		if (cap == Cap::none)
 		{
 			data.size = data.indices.size();
+			data.update_bounds();
+			return;
+		}
+
+		if (cap == Cap::triangulated)
+		{
+			const std::vector<int> triangles = shape->triangulate();
+			make_cap(data, object_first_index, centers.front(), tangents.front() * -1.0f, triangles, true);
+			make_cap(data, object_last_index - shape->size(), centers.back(), tangents.back(), triangles, false);
+			data.size = data.indices.size();
+			data.update_bounds();
 			return;
 		}
 
@@ -171,13 +795,63 @@ namespace Geometry
 		data.vertices.push_back(vertex);
 
 		// Add mesh for begin sector
-		Math_3d::Vector_3d normal = (path->get_point(0.0f) - path->get_point(path_delta)).normalize();
+		Math_3d::Vector_3d normal = tangents.front() * -1.0f;
 		make_solid(data, object_first_index, object_last_index, normal);
 		// Add mesh for end sector
-		normal = (path->get_point(1.0f) - path->get_point(1.0f - path_delta)).normalize();
+		normal = tangents.back();
 		make_solid(data, object_last_index - shape->size(), object_last_index + 1, normal);
 
 		data.size = data.indices.size();
+		data.update_bounds();
+	}
+
+	void Generator::make_lod(Object_Data& data, int level)
+	{
+		const int factor = 1 << level;
+		std::unique_ptr<Shape> full_shape = std::move(shape);
+		const float full_step = step;
+		const float full_chord_tolerance = chord_tolerance;
+		const float full_angle_tolerance = angle_tolerance;
+
+		// Chord error grows with square of slice spacing
+		shape = std::make_unique<Shape>(full_shape->coarsen(factor));
+		step = full_step * static_cast<float>(factor);
+		chord_tolerance = full_chord_tolerance * static_cast<float>(factor * factor);
+		angle_tolerance = std::min(full_angle_tolerance * static_cast<float>(factor), 60.0f);
+
+		make_mesh(data);
+
+		shape = std::move(full_shape);
+		step = full_step;
+		chord_tolerance = full_chord_tolerance;
+		angle_tolerance = full_angle_tolerance;
+	}
+
+	void Generator::make_cap(Object_Data& data, int ring_index, Math_3d::Vector_3d center, Math_3d::Vector_3d normal,
+							 const std::vector<int>& triangles, bool reverse)
+	{
+		// Own copy of ring, cap is flat shaded
+		const int first_index = data.vertices.size();
+		const int shape_size = shape->size();
+		Vertex vertex;
+		vertex.normal = normal;
+		for (int i = 0; i < shape_size; ++i)
+		{
+			vertex.pos = data.vertices[ring_index + i].pos;
+			data.vertices.push_back(vertex);
+		}
+		if (shape_size != shape->get_edges_number())
+		{
+			vertex.pos = center;
+			data.vertices.push_back(vertex);
+		}
+
+		for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+		{
+			data.indices.push_back(first_index + triangles[i]);
+			data.indices.push_back(first_index + triangles[reverse ? i + 2 : i + 1]);
+			data.indices.push_back(first_index + triangles[reverse ? i + 1 : i + 2]);
+		}
 	}
 
 	void Generator::make_solid(Object_Data& data, int abc_start_index, int center_index, Math_3d::Vector_3d normal)
@@ -275,71 +949,13 @@ namespace Geometry
 		}
 	}
 
-	void Generator::calc_normale(Object_Data& data, int start_index)
-	{
-		int n_steps = static_cast<int>(1.0f / step);
-		int curr_index, up_index, down_index, left_index, right_index;
-		// Calc normales
-		//      *      - up_index   -    *
-		//                  |
-		//  left_index - curr_index - right_index
-		//                  |
-		//      *      - down_index -    *
-
-		for (int i = 0; i < n_steps; ++i)
-		{
-			for (int j = 0; j < shape->size(); ++j)
-			{
-				curr_index = start_index + i * shape->size() + j;
-				up_index = start_index + (i - 1 < 0 ? i + 1 : i - 1) * shape->size() + j;
-				down_index = start_index + (i + 1 == n_steps ? i - 1 : i + 1) * shape->size() + j;
-				// If wrap
-				if (shape->size() == shape->get_edges_number())
-				{
-					left_index = start_index + i * shape->size() + (j - 1 < 0 ? shape->size() - 1 : j - 1);
-					right_index = start_index + i * shape->size() + (j + 1) % shape->size();
-				}
-				else
-				{
-					left_index = start_index + i * shape->size() + (j - 1 < 0 ? j + 1 : j - 1);
-					right_index = start_index + i * shape->size() + (j + 1 == shape->size() ? j - 1 : j + 1);
-				}
-
-				Math_3d::Vector_3d path_normal = (data.vertices[curr_index].pos -
-												  path->get_point(static_cast<float>(i) * step)).normalize();
-
-				Math_3d::Vector_3d u_vec = data.vertices[up_index].pos - data.vertices[curr_index].pos;
-				Math_3d::Vector_3d d_vec = data.vertices[down_index].pos - data.vertices[curr_index].pos;
-				Math_3d::Vector_3d l_vec = data.vertices[left_index].pos - data.vertices[curr_index].pos;
-				Math_3d::Vector_3d r_vec = data.vertices[right_index].pos - data.vertices[curr_index].pos;
-
-				auto check_normale = [path_normal](Math_3d::Vector_3d vec) -> Math_3d::Vector_3d
-				{
-					if (Math_3d::radian_to_degree(Math_3d::angle(path_normal, vec)) > 90.0f)
-					{
-						return vec * -1.0f;
-					}
-					return vec;
-				};
-
-				Math_3d::Vector_3d normale_1 = check_normale(u_vec ^ l_vec);
-				Math_3d::Vector_3d normale_2 = check_normale(u_vec ^ r_vec);
-				Math_3d::Vector_3d normale_3 = check_normale(d_vec ^ l_vec);
-				Math_3d::Vector_3d normale_4 = check_normale(d_vec ^ r_vec);
-
-				data.vertices[curr_index].normal = (normale_1 + normale_2 + normale_3 + normale_4).normalize();
-				data.vertices[curr_index].normal = check_normale(data.vertices[curr_index].normal);
-			}
-		}
-	}
-
 	Geometry::Geometry()
 	{
-		person = new Person;
+		person = new Person(nullptr, &arena);
 		person->create();
 		scene.push_back(person);
 
-		landscape = new Landscape;
+		landscape = new Landscape(nullptr, &arena);
 		landscape->create();
 		scene.push_back(landscape);
 	}
@@ -363,16 +979,13 @@ namespace Geometry
 	}
 
 
-	Person::Person(Object* base) : Object(base)
+	Person::Person(Object* base, Mesh_Arena* arena) : Object(base)
 	{
-		data = new Object_Data;
+		data = std::make_unique<Object_Data>(arena);
 		objects.push_back(this);
 	}
 
-	Person::~Person()
-	{
-		delete data;
-	}
+	Person::~Person() {}
 
 	void Person::create()
 	{
@@ -381,25 +994,25 @@ namespace Geometry
 			//Math_3d::Vector_3d(1.0f, 2.0f, -1.0f),
 			Math_3d::Vector_3d(0.0f, 1.0f, 0.0f) };
 		Math_3d::Vector_3d base_vec = Math_3d::Vector_3d(1.0f, 0.0f, 0.0f);
-		Generator mesh_generator(std::make_unique<Path>(control_points),
+		Generator mesh_generator(std::make_unique<Bezier_Path>(control_points),
 								 std::make_unique<Shape>(std::string("square"), 3.0f), base_vec);
+		mesh_generator.set_tessellation(Tessellation::adaptive);
 
-		mesh_generator.make_mesh(*data);
+		make_lods(mesh_generator, *data);
+		build_meshlets(*data);
+		data->set_vertex_format(vertex_format);
 
 		data->color = { 0.6f, 0.3f, 0.0f };
 	}
 
 
-	Landscape::Landscape(Object* base) : Object(base)
+	Landscape::Landscape(Object* base, Mesh_Arena* arena) : Object(base)
 	{
-		data = new Object_Data;
+		data = std::make_unique<Object_Data>(arena);
 		objects.push_back(this);
 	}
 
-	Landscape::~Landscape()
-	{
-		delete data;
-	}
+	Landscape::~Landscape() {}
 
 	void Landscape::create()
 	{
@@ -407,10 +1020,13 @@ namespace Geometry
 			Math_3d::Vector_3d(-50.0f, -5.0f, 0.0f),
 			Math_3d::Vector_3d(50.0f, -5.0f, 0.0f) };
 		Math_3d::Vector_3d base_vec = Math_3d::Vector_3d(0.0f, 1.0f, 0.0f);
-		Generator mesh_generator(std::make_unique<Path>(control_points),
+		Generator mesh_generator(std::make_unique<Bezier_Path>(control_points),
 			std::make_unique<Shape>(std::string("plane"), 100.0f), base_vec);
+		mesh_generator.set_tessellation(Tessellation::adaptive);
 
-		mesh_generator.make_mesh(*data);
+		make_lods(mesh_generator, *data);
+		build_meshlets(*data);
+		data->set_vertex_format(vertex_format);
 
 		data->color = { 0.0f, 0.3f, 0.4f };
 	}
@@ -418,10 +1034,7 @@ namespace Geometry
 
 	Object::Object(Object* base) : base(base)
 	{
-		data = nullptr;
 		id = obj_counter++;
-
-		pos = { 0.0f, 0.0f, 0.0f };
 	}
 
 	Object::~Object() {}
@@ -433,7 +1046,7 @@ namespace Geometry
 
 	Object_Data* Object::get_data()
 	{
-		return data;
+		return data.get();
 	}
 
 
@@ -441,10 +1054,7 @@ namespace Geometry
 	{
 		if (data != nullptr)
 		{
-			for (Vertex& vertex : data->vertices)
-			{
-				vertex.pos.y -= 10.0f;
-			}
+			data->transform.translate(Math_3d::Vector_3d(0.0f, -10.0f, 0.0f));
 		}
 		else
 		{
@@ -14,19 +14,82 @@
 #include <vector>
 #include <tuple>
 #include <memory>
+#include <mutex>
 
 #include "math_3d.h"
+#include "arc_length.h"
+#include "frame_table.h"
+#include "math_3d_bezier.h"
+#include "math_3d_spline.h"
+#include "index_buffer.h"
+#include "mesh_arena.h"
+#include "vertex_format.h"
+#include "math_3d_precision.h"
+#include "math_3d_transform.h"
 
 namespace Geometry
 {
 	/**
-	* @struct Vertex
-	* Base struct which represents single vertex
+	 * Precision policy of mesh generation,
+	 * Math_3d::Precision::Fast trades normals accuracy for speed
+	 */
+	using Precision = Math_3d::Precision::Exact;
+
+	/**
+	* @struct Lod_Level
+	* Level of detail: range of mesh indices drawn while
+	* object is smaller on screen than finer levels need
+	*/
+	struct Lod_Level
+	{
+		size_t first_index = 0;
+		size_t indices_number = 0;
+		size_t first_vertex = 0;
+		size_t vertices_number = 0;
+		/**
+		 * Level is used down to this projected diameter,
+		 * fraction of viewport height
+		 */
+		float min_screen_size = 0.0f;
+		/**
+		 * Meshlets of level in Object_Data::meshlets
+		 */
+		size_t first_meshlet = 0;
+		size_t meshlets_number = 0;
+	};
+
+	/**
+	* @struct Meshlet
+	* Cluster of consecutive triangles of mesh indices with
+	* bounding sphere and cone of triangle normals for culling
+	*/
+	struct Meshlet
+	{
+		uint32_t first_index = 0;
+		uint32_t indices_number = 0;
+		uint32_t vertices_number = 0;
+
+		Math_3d::Vector_3d center;
+		float radius = 0.0f;
+		/**
+		 * Unit average of triangle normals, cone_cutoff is sine of
+		 * largest angle between them, 1 if cone can not be culled
+		 */
+		Math_3d::Vector_3d cone_axis;
+		float cone_cutoff = 1.0f;
+	};
+
+	/**
+	* @struct Mesh_Bounds
+	* Axis aligned box and sphere around all vertices of mesh,
+	* sphere is centered in box
 	*/
-	struct Vertex
+	struct Mesh_Bounds
 	{
-		Math_3d::Vector_3d pos;
-		Math_3d::Vector_3d normal;
+		Math_3d::Vector_3d low = Math_3d::Vector_3d(0.0f, 0.0f, 0.0f);
+		Math_3d::Vector_3d high = Math_3d::Vector_3d(0.0f, 0.0f, 0.0f);
+		Math_3d::Vector_3d center = Math_3d::Vector_3d(0.0f, 0.0f, 0.0f);
+		float radius = 0.0f;
 	};
 
 	/**
@@ -37,12 +100,113 @@ namespace Geometry
 	struct Object_Data
 	{
 		int            size;
-		// vector<DWORD>  indices;
-		std::vector<unsigned long int>  indices;
-		std::vector<Vertex> vertices;
+		Index_Buffer   indices;
+		std::vector<Vertex, Arena_Allocator<Vertex>> vertices;
 		Math_3d::Vector_3d color;
+
+		/**
+		 * Layout streamed to GPU, compact_vertices and bounds
+		 * hold encoded vertices unless it is full
+		 */
+		Vertex_Format format = Vertex_Format::full;
+		std::vector<Compact_Vertex, Arena_Allocator<Compact_Vertex>> compact_vertices;
+		Vertex_Bounds bounds;
+
+		/**
+		 * Levels of detail, finest first, indices of each are
+		 * absolute. Empty if mesh has single level.
+		 */
+		std::vector<Lod_Level> lods;
+		/**
+		 * Bounds of vertices of every level in object space,
+		 * call update_bounds after vertices change
+		 */
+		Mesh_Bounds mesh_bounds;
+		/**
+		 * Placement in world, applied on GPU, so moving
+		 * object leaves vertices untouched
+		 */
+		Math_3d::Transform transform;
+		/**
+		 * Clusters of whole mesh or of every level, empty if not built
+		 */
+		std::vector<Meshlet> meshlets;
+
+		Object_Data() {};
+		/**
+		 * Buffers are placed in arena, nullptr means heap
+		 */
+		explicit Object_Data(Mesh_Arena* arena)
+		: indices(arena), vertices(Arena_Allocator<Vertex>(arena)),
+		  compact_vertices(Arena_Allocator<Compact_Vertex>(arena)) {};
+
+		/**
+		 * Set GPU layout and encode vertices to it,
+		 * call again after vertices change
+		 */
+		void set_vertex_format(Vertex_Format vertex_format);
+		void update_bounds();
 	};
 
+	/**
+	* @struct Mesh_Size
+	* Exact number of vertices and indices of generated mesh
+	*/
+	struct Mesh_Size
+	{
+		size_t vertices = 0;
+		size_t indices = 0;
+	};
+
+	/**
+	 * Placement of slices along path
+	 */
+	enum class Tessellation
+	{
+		/**
+		 * Slices evenly from t = 0 to t = 1, at most step apart
+		 */
+		fixed,
+		/**
+		 * Slices where path bends: interval is halved while
+		 * tangents differ by more than angle tolerance or path
+		 * leaves chord by more than chord tolerance.
+		 * Straight path gives two slices.
+		 */
+		adaptive
+	};
+
+	/**
+	 * End caps of generated mesh
+	 */
+	enum class Cap
+	{
+		none,
+		/**
+		 * End profile triangulated as is: fan if convex,
+		 * ear clipping otherwise. Open profile is closed
+		 * through path point. One ring of vertices per cap.
+		 */
+		triangulated,
+		/**
+		 * Triangle sector per profile edge to path point,
+		 * each one split by split_points
+		 */
+		subdivided
+	};
+
+
+	/**
+	* @struct Profile_Point
+	* Slice point: length along base_vec rotated to angle
+	* around path, angle is kept as its cos and sin
+	*/
+	struct Profile_Point
+	{
+		float length;
+		float cos_angle;
+		float sin_angle;
+	};
 
 	/**
 	* @class Shape
@@ -50,23 +214,53 @@ namespace Geometry
 	* Idea is - have some start point, vector and
 	* have a vector of {length, angle} for each point
 	* It means that need to go from start point to
-	* vector * length rotated to angle
+	* vector * length rotated to angle.
+	* Angles are stored as cos and sin, so sweeping
+	* a shape needs no trigonometry per vertex.
+	* 2D profile points are (x, y): x along base_vec,
+	* y along tangent ^ base_vec.
 	*/
 	class Shape
 	{
-		using data_type = std::vector<std::pair<float, float>>;
+		using data_type = std::vector<Profile_Point>;
+		using Unit_Circle = std::vector<std::pair<float, float>>;
 
 		bool wrap = true;
+		data_type data;
+
+		Shape() {};
 		/**
-		 * Shape point data:
-		 *  - Length
-		 *  - Angle
+		 * End profile as 2D polygon, closed through path point if open
 		 */
-		data_type data;
+		std::vector<std::pair<float, float>> get_polygon() const;
 
 	public:
+		/**
+		 * "square" or "plane" of given size
+		 */
 		Shape(std::string type, float size);
 
+		/**
+		 * Regular polygon of segments points on circle,
+		 * first one at base_vec
+		 */
+		static Shape circle(int segments, float radius);
+		/**
+		 * Points as is, wrap closes last point to first one
+		 */
+		static Shape polyline(const std::vector<std::pair<float, float>>& points, bool wrap);
+		/**
+		 * Spline of points sampled to segments edges,
+		 * wrapped one is periodic (catmull_rom or b_spline)
+		 */
+		static Shape spline(const std::vector<std::pair<float, float>>& points, int segments, bool wrap,
+							Math_3d::Spline::Type type = Math_3d::Spline::Type::catmull_rom);
+		/**
+		 * {cos, sin} of 2 * pi * i / segments, i < segments.
+		 * Computed once per segments number and shared (thread-safe).
+		 */
+		static std::shared_ptr<const Unit_Circle> get_unit_circle(int segments);
+
 		data_type::iterator begin();
 		data_type::iterator end();
 		data_type::const_iterator begin() const;
@@ -74,23 +268,109 @@ namespace Geometry
 
 		int size() const;
 		int get_edges_number() const;
+
+		/**
+		 * Triangles of end profile polygon, counter-clockwise looking
+		 * along path. Index size() stands for path point, used
+		 * by open profile only. Polygon of n points gives n - 2 triangles.
+		 */
+		std::vector<int> triangulate() const;
+		/**
+		 * Signed area of end profile polygon,
+		 * positive if counter-clockwise looking along path
+		 */
+		float get_area() const;
+
+		/**
+		 * Every factor-th point, end point of open profile is kept.
+		 * Same shape if fewer points would not make a profile.
+		 */
+		Shape coarsen(int factor) const;
 	};
 
 	/**
 	* @class Path
 	* 3D Path which represents object path.
-	* Implemented as Bezier curve of given
-	* control points.
+	* Curve of parameter t in [0, 1].
 	*/
 	class Path
 	{
-		std::vector<Math_3d::Vector_3d> control_points;
+		mutable std::once_flag arc_length_flag;
+		mutable Arc_Length_Table arc_length;
+		mutable std::once_flag frames_flag;
+		mutable Frame_Table frames;
+
+	public:
+		virtual ~Path() {};
+
+		virtual Math_3d::Vector_3d get_point(float t) const = 0;
+		/**
+		 * Derivative by t, not normalized
+		 */
+		virtual Math_3d::Vector_3d get_tangent(float t) const = 0;
+		/**
+		 * count points (tangents) evenly spaced from t0 to t1 inclusive
+		 */
+		virtual void sample(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const;
+		virtual void sample_tangents(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const;
+
+		/**
+		 * Distance <-> t table, built on first use (thread-safe)
+		 */
+		const Arc_Length_Table& get_arc_length() const;
+		/**
+		 * Point at distance from start, constant speed motion
+		 */
+		Math_3d::Vector_3d get_point_at_distance(float distance) const;
+		/**
+		 * out[i] = get_point_at_distance(distances[i])
+		 */
+		void sample_at_distances(const float* distances, size_t count, Math_3d::Vector_3d* out) const;
+
+		/**
+		 * Rotation minimizing frames, built on first use (thread-safe)
+		 * and shared by every shape swept along path
+		 */
+		const Frame_Table& get_frames() const;
+	};
+
+	/**
+	* @class Bezier_Path
+	* Single Bezier curve of given control points.
+	* Every point depends on all control points,
+	* good for short smooth paths.
+	*/
+	class Bezier_Path : public Path
+	{
+		Math_3d::Bezier curve;
 
 	public:
+		Bezier_Path(std::vector<Math_3d::Vector_3d> control_points);
 
-		Path(std::vector<Math_3d::Vector_3d> control_points);
+		virtual Math_3d::Vector_3d get_point(float t) const;
+		virtual Math_3d::Vector_3d get_tangent(float t) const;
+		virtual void sample(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const;
+		virtual void sample_tangents(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const;
+	};
 
-		Math_3d::Vector_3d get_point(float t) const;
+	/**
+	* @class Spline_Path
+	* Piecewise cubic path, each point depends on 4 control points.
+	* Sample cost does not grow with number of control points,
+	* good for long tubes, roads and vines.
+	*/
+	class Spline_Path : public Path
+	{
+		Math_3d::Spline curve;
+
+	public:
+		Spline_Path(std::vector<Math_3d::Vector_3d> control_points,
+					Math_3d::Spline::Type type = Math_3d::Spline::Type::catmull_rom);
+
+		virtual Math_3d::Vector_3d get_point(float t) const;
+		virtual Math_3d::Vector_3d get_tangent(float t) const;
+		virtual void sample(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const;
+		virtual void sample_tangents(float t0, float t1, size_t count, Math_3d::Vector_3d* out) const;
 	};
 
 	/**
@@ -103,14 +383,30 @@ namespace Geometry
 		std::unique_ptr<Shape> shape;
 		Math_3d::Vector_3d base_vec;
 
-		const float step = 0.02f;
+		float step = 0.02f;
 		const float path_delta = 0.01f;
-		bool solid = true;
+		Cap cap = Cap::triangulated;
 		int split_points = 3;
 		float sector_step = 1.0f / static_cast<float>(split_points + 1);
 
+		Tessellation tessellation = Tessellation::fixed;
+		float chord_tolerance = 0.01f;
+		float angle_tolerance = 5.0f;
+		// Up to 2^max_depth + 1 adaptive slices
+		const int max_depth = 10;
+
+		/**
+		 * Path parameters of slices, ascending from 0 to 1 for adaptive
+		 */
+		std::vector<float> get_slices() const;
+		void subdivide(float t0, float t1, int depth, float min_cos, std::vector<float>& slices) const;
+		Mesh_Size plan_mesh(size_t slices) const;
 		void make_solid(Object_Data& data, int start_index, int center_index, Math_3d::Vector_3d normal);
-		void calc_normale(Object_Data& data, int start_index);
+		/**
+		 * Cap of Cap::triangulated, triangles are reversed for begin cap
+		 */
+		void make_cap(Object_Data& data, int ring_index, Math_3d::Vector_3d center, Math_3d::Vector_3d normal,
+					  const std::vector<int>& triangles, bool reverse);
 
 	public:
 		Generator();
@@ -118,7 +414,26 @@ namespace Geometry
 
 		~Generator() {};
 
+		/**
+		 * Chord tolerance is in world units, angle tolerance in degrees
+		 */
+		void set_tessellation(Tessellation tessellation, float chord_tolerance = 0.01f, float angle_tolerance = 5.0f);
+		/**
+		 * split_points is used by Cap::subdivided
+		 */
+		void set_cap(Cap cap, int split_points = 3);
+
+		/**
+		 * Sizes make_mesh will append, computed from
+		 * shape, slices and split_points without building
+		 */
+		Mesh_Size plan_mesh() const;
 		void make_mesh(Object_Data& data);
+		/**
+		 * make_mesh of level of detail: every 2^level profile point,
+		 * 2^level times longer slice step or looser tolerances
+		 */
+		void make_lod(Object_Data& data, int level);
 	};
 
 	class Object
@@ -128,10 +443,13 @@ namespace Geometry
 		static int obj_counter;
 
 		Object* base;
-		Object_Data* data;
+		std::unique_ptr<Object_Data> data;
 		std::vector<Object*> components;
 
-		Math_3d::Vector_3d pos;
+		/**
+		 * GPU vertex layout of created meshes
+		 */
+		static const Vertex_Format vertex_format = Vertex_Format::fixed;
 
 	public:
 
@@ -150,6 +468,12 @@ namespace Geometry
 
 	class Geometry
 	{
+		/**
+		 * Mesh buffers of all objects, declared first
+		 * to be destroyed after them
+		 */
+		Mesh_Arena arena;
+
 		Object* person;
 		Object* landscape;
 
@@ -166,7 +490,7 @@ namespace Geometry
 	class Person : public Object
 	{
 	public:
-		Person(Object* base = nullptr);
+		Person(Object* base = nullptr, Mesh_Arena* arena = nullptr);
 		~Person();
 
 		virtual void create();
@@ -175,7 +499,7 @@ namespace Geometry
 	class Landscape : public Object
 	{
 	public:
-		Landscape(Object* base = nullptr);
+		Landscape(Object* base = nullptr, Mesh_Arena* arena = nullptr);
 		~Landscape();
 
 		virtual void create();
@@ -0,0 +1,176 @@
+/******************************************************************************
+	 * File: index_buffer.cpp
+	 * Description: Contains index storage of 16 or 32 bit width.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include "index_buffer.h"
+
+namespace Geometry
+{
+	Index_Buffer::Index_Buffer(Mesh_Arena* arena)
+	: indices_16(Arena_Allocator<uint16_t>(arena)), indices_32(Arena_Allocator<uint32_t>(arena)) {}
+
+	void Index_Buffer::widen()
+	{
+		indices_32.reserve(indices_16.capacity());
+		indices_32.assign(indices_16.begin(), indices_16.end());
+		indices_16.clear();
+		indices_16.shrink_to_fit();
+		wide = true;
+	}
+
+	void Index_Buffer::set_vertex_count(size_t vertex_count)
+	{
+		if (vertex_count > max_narrow_vertices)
+		{
+			if (!wide)
+			{
+				widen();
+			}
+			return;
+		}
+		if (!wide)
+		{
+			return;
+		}
+
+		for (uint32_t index : indices_32)
+		{
+			if (index >= max_narrow_vertices)
+			{
+				return;
+			}
+		}
+		indices_16.reserve(indices_32.capacity());
+		indices_16.resize(indices_32.size());
+		for (size_t i = 0; i < indices_32.size(); ++i)
+		{
+			indices_16[i] = static_cast<uint16_t>(indices_32[i]);
+		}
+		indices_32.clear();
+		indices_32.shrink_to_fit();
+		wide = false;
+	}
+
+	bool Index_Buffer::is_wide() const
+	{
+		return wide;
+	}
+
+	size_t Index_Buffer::get_index_size() const
+	{
+		return wide ? sizeof(uint32_t) : sizeof(uint16_t);
+	}
+
+	size_t Index_Buffer::size() const
+	{
+		return wide ? indices_32.size() : indices_16.size();
+	}
+
+	bool Index_Buffer::empty() const
+	{
+		return size() == 0;
+	}
+
+	size_t Index_Buffer::get_bytes() const
+	{
+		return size() * get_index_size();
+	}
+
+	void Index_Buffer::clear()
+	{
+		indices_16.clear();
+		indices_32.clear();
+	}
+
+	void Index_Buffer::reserve(size_t count)
+	{
+		if (wide)
+		{
+			indices_32.reserve(count);
+		}
+		else
+		{
+			indices_16.reserve(count);
+		}
+	}
+
+	void Index_Buffer::resize(size_t count)
+	{
+		if (wide)
+		{
+			indices_32.resize(count);
+		}
+		else
+		{
+			indices_16.resize(count);
+		}
+	}
+
+	uint32_t Index_Buffer::operator[](size_t i) const
+	{
+		return wide ? indices_32[i] : indices_16[i];
+	}
+
+	void Index_Buffer::set(size_t i, uint32_t index)
+	{
+		if (!wide && index >= max_narrow_vertices)
+		{
+			widen();
+		}
+		if (wide)
+		{
+			indices_32[i] = index;
+		}
+		else
+		{
+			indices_16[i] = static_cast<uint16_t>(index);
+		}
+	}
+
+	void Index_Buffer::push_back(uint32_t index)
+	{
+		if (!wide && index >= max_narrow_vertices)
+		{
+			widen();
+		}
+		if (wide)
+		{
+			indices_32.push_back(index);
+		}
+		else
+		{
+			indices_16.push_back(static_cast<uint16_t>(index));
+		}
+	}
+
+	const void* Index_Buffer::data() const
+	{
+		return wide ? static_cast<const void*>(indices_32.data()) : static_cast<const void*>(indices_16.data());
+	}
+
+	uint16_t* Index_Buffer::data_16()
+	{
+		return wide ? nullptr : indices_16.data();
+	}
+
+	uint32_t* Index_Buffer::data_32()
+	{
+		return wide ? indices_32.data() : nullptr;
+	}
+
+	const uint16_t* Index_Buffer::data_16() const
+	{
+		return wide ? nullptr : indices_16.data();
+	}
+
+	const uint32_t* Index_Buffer::data_32() const
+	{
+		return wide ? indices_32.data() : nullptr;
+	}
+}
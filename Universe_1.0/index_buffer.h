@@ -0,0 +1,80 @@
+/******************************************************************************
+	 * File: index_buffer.h
+	 * Description: Contains index storage of 16 or 32 bit width.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "mesh_arena.h"
+
+namespace Geometry
+{
+	/**
+	* @class Index_Buffer
+	* Triangle indices stored as uint16_t while every index fits,
+	* as uint32_t otherwise. Same layout on every platform,
+	* data() can be uploaded as DXGI R16_UINT / R32_UINT as is.
+	* Storing an index which does not fit 16 bits widens the buffer,
+	* so call set_vertex_count first when filling from several threads.
+	*/
+	class Index_Buffer
+	{
+		std::vector<uint16_t, Arena_Allocator<uint16_t>> indices_16;
+		std::vector<uint32_t, Arena_Allocator<uint32_t>> indices_32;
+		bool wide = false;
+
+		void widen();
+
+	public:
+		static const size_t max_narrow_vertices = 65536;
+
+		Index_Buffer() {};
+		/**
+		 * Storage is placed in arena, nullptr means heap
+		 */
+		explicit Index_Buffer(Mesh_Arena* arena);
+
+		/**
+		 * Pick width for mesh of vertex_count vertices:
+		 * 16 bit up to 65536 vertices (indices 0..65535),
+		 * 32 bit otherwise.
+		 * Stored indices are converted.
+		 */
+		void set_vertex_count(size_t vertex_count);
+
+		bool is_wide() const;
+		/**
+		 * Bytes per index, 2 or 4
+		 */
+		size_t get_index_size() const;
+
+		size_t size() const;
+		bool empty() const;
+		size_t get_bytes() const;
+
+		void clear();
+		void reserve(size_t count);
+		void resize(size_t count);
+
+		uint32_t operator[](size_t i) const;
+		void set(size_t i, uint32_t index);
+		void push_back(uint32_t index);
+
+		const void* data() const;
+		/**
+		 * Typed storage, nullptr if buffer has other width
+		 */
+		uint16_t* data_16();
+		uint32_t* data_32();
+		const uint16_t* data_16() const;
+		const uint32_t* data_32() const;
+	};
+}
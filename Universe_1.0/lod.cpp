@@ -0,0 +1,111 @@
+/******************************************************************************
+	 * File: lod.cpp
+	 * Description: Contains levels of detail building and selection.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <math.h>
+#include <stdint.h>
+
+#include "lod.h"
+#include "mesh_cleanup.h"
+#include "mesh_optimizer.h"
+
+namespace Geometry
+{
+	namespace
+	{
+		// Level is kept if it has at most this part of triangles of previous one
+		const float min_reduction = 0.75f;
+	}
+
+	void make_lods(Generator& generator, Object_Data& data, int levels_number, float screen_size)
+	{
+		data.lods.clear();
+
+		// All levels first, so arena buffers of data grow once
+		std::vector<Object_Data> levels;
+		size_t total_vertices = data.vertices.size();
+		size_t total_indices = data.indices.size();
+		for (int level = 0; level < levels_number; ++level)
+		{
+			Object_Data level_data;
+			generator.make_lod(level_data, level);
+			clean_mesh(level_data);
+			optimize_mesh(level_data);
+
+			if (!levels.empty() &&
+				static_cast<float>(level_data.indices.size()) > min_reduction * static_cast<float>(levels.back().indices.size()))
+			{
+				break;
+			}
+			total_vertices += level_data.vertices.size();
+			total_indices += level_data.indices.size();
+			levels.push_back(std::move(level_data));
+		}
+
+		data.vertices.reserve(total_vertices);
+		data.indices.set_vertex_count(total_vertices);
+		data.indices.reserve(total_indices);
+		for (size_t level = 0; level < levels.size(); ++level)
+		{
+			const Object_Data& level_data = levels[level];
+			Lod_Level lod;
+			lod.first_vertex = data.vertices.size();
+			lod.vertices_number = level_data.vertices.size();
+			lod.first_index = data.indices.size();
+			lod.indices_number = level_data.indices.size();
+			lod.min_screen_size = screen_size / static_cast<float>(1 << level);
+
+			data.vertices.insert(data.vertices.end(), level_data.vertices.begin(), level_data.vertices.end());
+			data.indices.resize(lod.first_index + lod.indices_number);
+			for (size_t i = 0; i < lod.indices_number; ++i)
+			{
+				data.indices.set(lod.first_index + i, static_cast<uint32_t>(lod.first_vertex + level_data.indices[i]));
+			}
+			data.lods.push_back(lod);
+		}
+		if (data.lods.empty())
+		{
+			return;
+		}
+
+		// Coarsest level is drawn however small object is
+		data.lods.back().min_screen_size = 0.0f;
+		// Whole mesh is level 0 for code which knows nothing of levels
+		data.size = static_cast<int>(data.lods.front().indices_number);
+		data.update_bounds();
+	}
+
+	size_t select_lod(const Object_Data& data, const Math_3d::Matrix_4x4& view, const Math_3d::Matrix_4x4& projection)
+	{
+		if (data.lods.empty())
+		{
+			return 0;
+		}
+
+		// Depth of sphere center in view space, camera inside sphere sees full detail
+		const Math_3d::Vector_3d center = Math_3d::transform_point(data.mesh_bounds.center, data.transform.get_matrix());
+		const float radius = data.mesh_bounds.radius * data.transform.get_max_scale();
+		const float depth = Math_3d::transform_point(center, view).z;
+		if (depth <= radius)
+		{
+			return 0;
+		}
+		// Projected diameter over viewport height: 2r * m11 / depth over NDC height 2
+		const float screen_size = radius * projection.m[1][1] / depth;
+
+		for (size_t level = 0; level < data.lods.size(); ++level)
+		{
+			if (screen_size >= data.lods[level].min_screen_size)
+			{
+				return level;
+			}
+		}
+		return data.lods.size() - 1;
+	}
+}
@@ -0,0 +1,36 @@
+/******************************************************************************
+	 * File: lod.h
+	 * Description: Contains levels of detail building and selection.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+
+#include "geometry.h"
+#include "math_3d_matrix.h"
+
+namespace Geometry
+{
+	/**
+	 * Append up to levels_number levels of detail made by
+	 * Generator::make_lod to data, each one cleaned and optimized
+	 * on its own. Chain stops at level which removes less than
+	 * a quarter of triangles of previous one.
+	 * Level 0 is used from screen_size (projected diameter as
+	 * fraction of viewport height), each next one from half
+	 * of that of previous, last one down to zero. Halving detail
+	 * as size halves keeps error on screen about the same.
+	 */
+	void make_lods(Generator& generator, Object_Data& data, int levels_number = 3, float screen_size = 0.5f);
+
+	/**
+	 * Level of data.lods for camera view and projection
+	 * at data.transform, 0 if there are no levels
+	 */
+	size_t select_lod(const Object_Data& data, const Math_3d::Matrix_4x4& view, const Math_3d::Matrix_4x4& projection);
+}
@@ -9,6 +9,7 @@
 ******************************************************************************/
 
 #include "math_3d.h"
+#include "math_3d_rotation.h"
 
 namespace Math_3d
 {
@@ -50,27 +51,8 @@ namespace Math_3d
 
 	Vector_3d rotate_vector(Vector_3d vector, Vector_3d axis, float angle)
 	{
-		angle = degree_to_radian(angle);
-		// Rotation matrix
-		std::vector<Vector_3d> matrix = {
-			Vector_3d(cos(angle) + (1 - cos(angle)) * axis.x * axis.x,
-					 (1 - cos(angle)) * axis.x * axis.y - sin(angle) * axis.z,
-					 (1 - cos(angle)) * axis.x * axis.z + sin(angle) * axis.y),
-			Vector_3d((1 - cos(angle)) * axis.x * axis.y + sin(angle) * axis.z,
-					 cos(angle) + (1 - cos(angle)) * axis.y * axis.y,
-					 (1 - cos(angle)) * axis.y * axis.z - sin(angle) * axis.x),
-			Vector_3d((1 - cos(angle)) * axis.x * axis.z - sin(angle) * axis.y,
-					 (1 - cos(angle)) * axis.y * axis.z + sin(angle) * axis.x,
-					 cos(angle) + (1 - cos(angle)) * axis.z * axis.z)
-		};
-
-		Vector_3d result = {
-			matrix[0] & vector,
-			matrix[1] & vector,
-			matrix[2] & vector
-		};
-
-		return result;
+		// Callers rotating many vectors should keep the Rotation instead
+		return Rotation(axis, angle).apply(vector);
 	}
 
 	bool Vector_3d::is_zero()
@@ -103,166 +85,6 @@ namespace Math_3d
 		return *this;
 	}
 
-	Vector_3d& Vector_3d::operator=(const Vector_3d& vec)
-	{
-		if (this != &vec)
-		{
-			x = vec.x;
-			y = vec.y;
-			z = vec.z;
-		}
-
-		return *this;
-	}
-
-	Vector_3d& Vector_3d::operator+=(const float& num)
-	{
-		x += num; y += num; z += num;
-		return *this;
-	}
-	Vector_3d& Vector_3d::operator-=(const float& num)
-	{
-		x -= num; y -= num; z -= num;
-		return *this;
-	}
-	Vector_3d& Vector_3d::operator*=(const float& num)
-	{
-		x *= num; y *= num; z *= num;
-		return *this;
-	}
-	Vector_3d& Vector_3d::operator/=(const float& num)
-	{
-		x /= num; y /= num; z /= num;
-		return *this;
-	}
-	Vector_3d& Vector_3d::operator+=(const Vector_3d& vec)
-	{
-		x += vec.x; y += vec.y; z += vec.z;
-		return *this;
-	}
-	Vector_3d& Vector_3d::operator-=(const Vector_3d& vec)
-	{
-		x -= vec.x; y -= vec.y; z -= vec.z;
-		return *this;
-	}
-	Vector_3d& Vector_3d::operator*=(const Vector_3d& vec)
-	{
-		x *= vec.x; y *= vec.y; z *= vec.z;
-		return *this;
-	}
-	Vector_3d& Vector_3d::operator/=(const Vector_3d& vec)
-	{
-		x /= vec.x; y /= vec.y; z /= vec.z;
-		return *this;
-	}
-
-	/**
-	 * Scalar cross product
-	 */
-	float Vector_3d::operator&=(const Vector_3d& vec)
-	{
-		return x * vec.x + y * vec.y + z * vec.z;
-	}
-	/**
-	 * Vector cross product
-	 */
-	Vector_3d& Vector_3d::operator^=(const Vector_3d& vec)
-	{
-		x = y * vec.z - z * vec.y;
-		y = z * vec.x - x * vec.z;
-		z = x * vec.y - y * vec.x;
-		return *this;
-	}
-
-	Vector_3d::operator Vector_4d()
-	{
-		return { x, y, z, 1.0f };
-	}
-
-	Vector_3d operator+(const Vector_3d& vec_a, const Vector_3d& vec_b)
-	{
-		return { vec_a.x + vec_b.x, vec_a.y + vec_b.y, vec_a.z + vec_b.z };
-	}
-	Vector_3d operator-(const Vector_3d& vec_a, const Vector_3d& vec_b)
-	{
-		return { vec_a.x - vec_b.x, vec_a.y - vec_b.y, vec_a.z - vec_b.z };
-	}
-	Vector_3d operator*(const Vector_3d& vec_a, const Vector_3d& vec_b)
-	{
-		return { vec_a.x * vec_b.x, vec_a.y * vec_b.y, vec_a.z * vec_b.z };
-	}
-	Vector_3d operator/(const Vector_3d& vec_a, const Vector_3d& vec_b)
-	{
-		return { vec_a.x / vec_b.x, vec_a.y / vec_b.y, vec_a.z / vec_b.z };
-	}
-	/**
-	 * Scalar cross product
-	 */
-	float operator&(const Vector_3d& vec_a, const Vector_3d& vec_b)
-	{
-		return vec_a.x * vec_b.x + vec_a.y * vec_b.y + vec_a.z * vec_b.z;
-	}
-	/**
-	 * Vector cross product
-	 */
-	Vector_3d operator^(const Vector_3d& vec_a, const Vector_3d& vec_b)
-	{
-		return { vec_a.y * vec_b.z - vec_a.z * vec_b.y,
-				 vec_a.z * vec_b.x - vec_a.x * vec_b.z,
-				 vec_a.x * vec_b.y - vec_a.y * vec_b.x };
-	}
-
-	bool operator==(const Vector_3d& vec_a, const Vector_3d& vec_b)
-	{
-		if ((vec_a.x - vec_b.x) * (vec_a.x - vec_b.x) > eps)
-			return false;
-
-		if ((vec_a.y - vec_b.y) * (vec_a.y - vec_b.y) > eps)
-			return false;
-
-		if ((vec_a.z - vec_b.z) * (vec_a.z - vec_b.z) > eps)
-			return false;
-
-		return true;
-	}
-	bool operator!=(const Vector_3d& vec_a, const Vector_3d& vec_b)
-	{
-		return !(vec_a == vec_b);
-	}
-
-	Vector_3d operator+(const float& num, const Vector_3d& vec)
-	{
-		return { num + vec.x, num + vec.y, num + vec.z };
-	}
-	Vector_3d operator-(const float& num, const Vector_3d& vec)
-	{
-		return { num - vec.x, num - vec.y, num - vec.z };
-	}
-	Vector_3d operator*(const float& num, const Vector_3d& vec)
-	{
-		return { num * vec.x, num * vec.y, num * vec.z };
-	}
-	Vector_3d operator/(const float& num, const Vector_3d& vec)
-	{
-		return { num / vec.x, num / vec.y, num / vec.z };
-	}
-	Vector_3d operator+(const Vector_3d& vec, const float& num)
-	{
-		return { vec.x + num, vec.y + num, vec.z + num };
-	}
-	Vector_3d operator-(const Vector_3d& vec, const float& num)
-	{
-		return { vec.x - num, vec.y - num, vec.z - num };
-	}
-	Vector_3d operator*(const Vector_3d& vec, const float& num)
-	{
-		return { vec.x * num, vec.y * num, vec.z * num };
-	}
-	Vector_3d operator/(const Vector_3d& vec, const float& num)
-	{
-		return { vec.x / num, vec.y / num, vec.z / num };
-	}
-
 	float distance(Vector_3d vec_a, Vector_3d vec_b)
 	{
 		double vec_a_x = static_cast<double>(vec_a.x);
@@ -330,131 +152,4 @@ namespace Math_3d
 		z = z > 1.0f ? 1.0f : z;
 		return *this;
 	}
-
-	Vector_4d& Vector_4d::operator=(const Vector_4d& vec)
-	{
-		if (this != &vec)
-		{
-			x = vec.x;
-			y = vec.y;
-			z = vec.z;
-			w = vec.w;
-		}
-
-		return *this;
-	}
-
-	Vector_4d& Vector_4d::operator+=(const float& num)
-	{
-		x += num; y += num; z += num;
-		return *this;
-	}
-	Vector_4d& Vector_4d::operator-=(const float& num)
-	{
-		x -= num; y -= num; z -= num;
-		return *this;
-	}
-	Vector_4d& Vector_4d::operator*=(const float& num)
-	{
-		x *= num; y *= num; z *= num;
-		return *this;
-	}
-	Vector_4d& Vector_4d::operator/=(const float& num)
-	{
-		x /= num; y /= num; z /= num;
-		return *this;
-	}
-	Vector_4d& Vector_4d::operator+=(const Vector_4d& vec)
-	{
-		x += vec.x; y += vec.y; z += vec.z;
-		return *this;
-	}
-	Vector_4d& Vector_4d::operator-=(const Vector_4d& vec)
-	{
-		x -= vec.x; y -= vec.y; z -= vec.z;
-		return *this;
-	}
-	Vector_4d& Vector_4d::operator*=(const Vector_4d& vec)
-	{
-		x *= vec.x; y *= vec.y; z *= vec.z;
-		return *this;
-	}
-	Vector_4d& Vector_4d::operator/=(const Vector_4d& vec)
-	{
-		x /= vec.x; y /= vec.y; z /= vec.z;
-		return *this;
-	}
-
-	Vector_4d::operator Vector_3d()
-	{
-		return { x, y, z };
-	}
-
-	Vector_4d operator+(const Vector_4d& vec_a, const Vector_4d& vec_b)
-	{
-		return { vec_a.x + vec_b.x, vec_a.y + vec_b.y, vec_a.z + vec_b.z, 1.0f };
-	}
-	Vector_4d operator-(const Vector_4d& vec_a, const Vector_4d& vec_b)
-	{
-		return { vec_a.x - vec_b.x, vec_a.y - vec_b.y, vec_a.z - vec_b.z, 1.0f };
-	}
-	Vector_4d operator*(const Vector_4d& vec_a, const Vector_4d& vec_b)
-	{
-		return { vec_a.x * vec_b.x, vec_a.y * vec_b.y, vec_a.z * vec_b.z, 1.0f };
-	}
-	Vector_4d operator/(const Vector_4d& vec_a, const Vector_4d& vec_b)
-	{
-		return { vec_a.x / vec_b.x, vec_a.y / vec_b.y, vec_a.z / vec_b.z, 1.0f };
-	}
-
-	bool operator==(const Vector_4d& vec_a, const Vector_4d& vec_b)
-	{
-		if ((vec_a.x - vec_b.x) * (vec_a.x - vec_b.x) > eps)
-			return false;
-
-		if ((vec_a.y - vec_b.y) * (vec_a.y - vec_b.y) > eps)
-			return false;
-
-		if ((vec_a.z - vec_b.z) * (vec_a.z - vec_b.z) > eps)
-			return false;
-
-		return true;
-	}
-	bool operator!=(const Vector_4d& vec_a, const Vector_4d& vec_b)
-	{
-		return !(vec_a == vec_b);
-	}
-
-	Vector_4d operator+(const float& num, const Vector_4d& vec)
-	{
-		return { num + vec.x, num + vec.y, num + vec.z, 1.0f };
-	}
-	Vector_4d operator-(const float& num, const Vector_4d& vec)
-	{
-		return { num - vec.x, num - vec.y, num - vec.z, 1.0f };
-	}
-	Vector_4d operator*(const float& num, const Vector_4d& vec)
-	{
-		return { num * vec.x, num * vec.y, num * vec.z, 1.0f };
-	}
-	Vector_4d operator/(const float& num, const Vector_4d& vec)
-	{
-		return { num / vec.x, num / vec.y, num / vec.z, 1.0f };
-	}
-	Vector_4d operator+(const Vector_4d& vec, const float& num)
-	{
-		return { vec.x + num, vec.y + num, vec.z + num, 1.0f };
-	}
-	Vector_4d operator-(const Vector_4d& vec, const float& num)
-	{
-		return { vec.x - num, vec.y - num, vec.z - num, 1.0f };
-	}
-	Vector_4d operator*(const Vector_4d& vec, const float& num)
-	{
-		return { vec.x * num, vec.y * num, vec.z * num, 1.0f };
-	}
-	Vector_4d operator/(const Vector_4d& vec, const float& num)
-	{
-		return { vec.x / num, vec.y / num, vec.z / num, 1.0f };
-	}
 }
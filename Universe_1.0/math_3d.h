@@ -15,8 +15,8 @@
 
 namespace Math_3d
 {
-	const float eps = 0.00000001f;
-	const float pi = 3.14159265358979323846f;
+	constexpr float eps = 0.00000001f;
+	constexpr float pi = 3.14159265358979323846f;
 
 	using Vector_3d = struct Vector_3d;
 	using Vector_4d = struct Vector_4d;
@@ -40,62 +40,165 @@ namespace Math_3d
 		float y = 0.0f;
 		float z = 0.0f;
 
-		Vector_3d() {};
-		Vector_3d(float x, float y, float z) : x(x), y(y), z(z) {};
-		Vector_3d(const Vector_3d& vec) = default;
+		constexpr Vector_3d() {};
+		constexpr Vector_3d(float x, float y, float z) : x(x), y(y), z(z) {};
+		constexpr Vector_3d(const Vector_3d& vec) = default;
 
 		bool is_zero();
 		float length();
 		Vector_3d& normalize();
 		Vector_3d& trunc();
 
-		Vector_3d& operator=(const Vector_3d& vec);
+		Vector_3d& operator=(const Vector_3d& vec) = default;
 
-		Vector_3d& operator+=(const float& num);
-		Vector_3d& operator-=(const float& num);
-		Vector_3d& operator*=(const float& num);
-		Vector_3d& operator/=(const float& num);
-		Vector_3d& operator+=(const Vector_3d& vec);
-		Vector_3d& operator-=(const Vector_3d& vec);
-		Vector_3d& operator*=(const Vector_3d& vec);
-		Vector_3d& operator/=(const Vector_3d& vec);
+		/**
+		 * Operators are inline constexpr, so chains like
+		 * a + (b * c + d * e) * f compile to plain float math
+		 */
+		constexpr Vector_3d& operator+=(const float& num)
+		{
+			x += num; y += num; z += num;
+			return *this;
+		}
+		constexpr Vector_3d& operator-=(const float& num)
+		{
+			x -= num; y -= num; z -= num;
+			return *this;
+		}
+		constexpr Vector_3d& operator*=(const float& num)
+		{
+			x *= num; y *= num; z *= num;
+			return *this;
+		}
+		constexpr Vector_3d& operator/=(const float& num)
+		{
+			x /= num; y /= num; z /= num;
+			return *this;
+		}
+		constexpr Vector_3d& operator+=(const Vector_3d& vec)
+		{
+			x += vec.x; y += vec.y; z += vec.z;
+			return *this;
+		}
+		constexpr Vector_3d& operator-=(const Vector_3d& vec)
+		{
+			x -= vec.x; y -= vec.y; z -= vec.z;
+			return *this;
+		}
+		constexpr Vector_3d& operator*=(const Vector_3d& vec)
+		{
+			x *= vec.x; y *= vec.y; z *= vec.z;
+			return *this;
+		}
+		constexpr Vector_3d& operator/=(const Vector_3d& vec)
+		{
+			x /= vec.x; y /= vec.y; z /= vec.z;
+			return *this;
+		}
 		/**
 		 * Scalar cross product
 		 * a = (x1, y1, z1); b = (x2, y2, z2)
 		 * a & b = 
 		 * x1 * x2 + y1 * y2 + z1 * z2
 		 */
-		float operator&=(const Vector_3d& vec);
+		constexpr float operator&=(const Vector_3d& vec)
+		{
+			return x * vec.x + y * vec.y + z * vec.z;
+		}
 		/**
 		 * Vector cross product
 		 * a = (x1, y1, z1); b = (x2, y2, z2)
 		 * a ^ b = 
 		 * (y1 * z2 - z1 * y2, z1 * x2 - x1 * z2, x1 * y2 - y1 * x2)
 		 */
-		Vector_3d& operator^=(const Vector_3d& vec);
+		constexpr Vector_3d& operator^=(const Vector_3d& vec)
+		{
+			x = y * vec.z - z * vec.y;
+			y = z * vec.x - x * vec.z;
+			z = x * vec.y - y * vec.x;
+			return *this;
+		}
 
-		operator Vector_4d();
+		constexpr operator Vector_4d();
 	};
 
-	Vector_3d operator+(const Vector_3d& vec_a, const Vector_3d& vec_b);
-	Vector_3d operator-(const Vector_3d& vec_a, const Vector_3d& vec_b);
-	Vector_3d operator*(const Vector_3d& vec_a, const Vector_3d& vec_b);
-	Vector_3d operator/(const Vector_3d& vec_a, const Vector_3d& vec_b);
+	constexpr Vector_3d operator+(const Vector_3d& vec_a, const Vector_3d& vec_b)
+	{
+		return { vec_a.x + vec_b.x, vec_a.y + vec_b.y, vec_a.z + vec_b.z };
+	}
+	constexpr Vector_3d operator-(const Vector_3d& vec_a, const Vector_3d& vec_b)
+	{
+		return { vec_a.x - vec_b.x, vec_a.y - vec_b.y, vec_a.z - vec_b.z };
+	}
+	constexpr Vector_3d operator*(const Vector_3d& vec_a, const Vector_3d& vec_b)
+	{
+		return { vec_a.x * vec_b.x, vec_a.y * vec_b.y, vec_a.z * vec_b.z };
+	}
+	constexpr Vector_3d operator/(const Vector_3d& vec_a, const Vector_3d& vec_b)
+	{
+		return { vec_a.x / vec_b.x, vec_a.y / vec_b.y, vec_a.z / vec_b.z };
+	}
 
-	float operator&(const Vector_3d& vec_a, const Vector_3d& vec_b);
-	Vector_3d operator^(const Vector_3d& vec_a, const Vector_3d& vec_b);
+	/**
+	 * Scalar cross product
+	 */
+	constexpr float operator&(const Vector_3d& vec_a, const Vector_3d& vec_b)
+	{
+		return vec_a.x * vec_b.x + vec_a.y * vec_b.y + vec_a.z * vec_b.z;
+	}
+	/**
+	 * Vector cross product
+	 */
+	constexpr Vector_3d operator^(const Vector_3d& vec_a, const Vector_3d& vec_b)
+	{
+		return { vec_a.y * vec_b.z - vec_a.z * vec_b.y,
+				 vec_a.z * vec_b.x - vec_a.x * vec_b.z,
+				 vec_a.x * vec_b.y - vec_a.y * vec_b.x };
+	}
 
-	bool operator==(const Vector_3d& vec_a, const Vector_3d& vec_b);
-	bool operator!=(const Vector_3d& vec_a, const Vector_3d& vec_b);
+	constexpr bool operator==(const Vector_3d& vec_a, const Vector_3d& vec_b)
+	{
+		return (vec_a.x - vec_b.x) * (vec_a.x - vec_b.x) <= eps &&
+			   (vec_a.y - vec_b.y) * (vec_a.y - vec_b.y) <= eps &&
+			   (vec_a.z - vec_b.z) * (vec_a.z - vec_b.z) <= eps;
+	}
+	constexpr bool operator!=(const Vector_3d& vec_a, const Vector_3d& vec_b)
+	{
+		return !(vec_a == vec_b);
+	}
 
-	Vector_3d operator+(const float& num, const Vector_3d& vec);
-	Vector_3d operator-(const float& num, const Vector_3d& vec);
-	Vector_3d operator*(const float& num, const Vector_3d& vec);
-	Vector_3d operator/(const float& num, const Vector_3d& vec);
-	Vector_3d operator+(const Vector_3d& vec, const float& num);
-	Vector_3d operator-(const Vector_3d& vec, const float& num);
-	Vector_3d operator*(const Vector_3d& vec, const float& num);
-	Vector_3d operator/(const Vector_3d& vec, const float& num);
+	constexpr Vector_3d operator+(const float& num, const Vector_3d& vec)
+	{
+		return { num + vec.x, num + vec.y, num + vec.z };
+	}
+	constexpr Vector_3d operator-(const float& num, const Vector_3d& vec)
+	{
+		return { num - vec.x, num - vec.y, num - vec.z };
+	}
+	constexpr Vector_3d operator*(const float& num, const Vector_3d& vec)
+	{
+		return { num * vec.x, num * vec.y, num * vec.z };
+	}
+	constexpr Vector_3d operator/(const float& num, const Vector_3d& vec)
+	{
+		return { num / vec.x, num / vec.y, num / vec.z };
+	}
+	constexpr Vector_3d operator+(const Vector_3d& vec, const float& num)
+	{
+		return { vec.x + num, vec.y + num, vec.z + num };
+	}
+	constexpr Vector_3d operator-(const Vector_3d& vec, const float& num)
+	{
+		return { vec.x - num, vec.y - num, vec.z - num };
+	}
+	constexpr Vector_3d operator*(const Vector_3d& vec, const float& num)
+	{
+		return { vec.x * num, vec.y * num, vec.z * num };
+	}
+	constexpr Vector_3d operator/(const Vector_3d& vec, const float& num)
+	{
+		return { vec.x / num, vec.y / num, vec.z / num };
+	}
 
 	float distance(Vector_3d vec_a, Vector_3d vec_b);
 	float distance(Vector_3d vec_a, Vector_4d vec_b);
@@ -117,43 +220,131 @@ namespace Math_3d
 		float z = 0.0f;
 		float w = 0.0f;
 
-		Vector_4d() {};
-		Vector_4d(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {};
-		Vector_4d(const Vector_4d& vec) = default;
+		constexpr Vector_4d() {};
+		constexpr Vector_4d(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {};
+		constexpr Vector_4d(const Vector_4d& vec) = default;
 
 		float length();
 		Vector_4d& normalize();
 		Vector_4d& trunc();
 
-		Vector_4d& operator= (const Vector_4d& vec);
+		Vector_4d& operator= (const Vector_4d& vec) = default;
 
-		Vector_4d& operator+=(const float& num);
-		Vector_4d& operator-=(const float& num);
-		Vector_4d& operator*=(const float& num);
-		Vector_4d& operator/=(const float& num);
-		Vector_4d& operator+=(const Vector_4d& vec);
-		Vector_4d& operator-=(const Vector_4d& vec);
-		Vector_4d& operator*=(const Vector_4d& vec);
-		Vector_4d& operator/=(const Vector_4d& vec);
+		/**
+		 * Component-wise operators change x, y, z only,
+		 * binary ones give w = 1
+		 */
+		constexpr Vector_4d& operator+=(const float& num)
+		{
+			x += num; y += num; z += num;
+			return *this;
+		}
+		constexpr Vector_4d& operator-=(const float& num)
+		{
+			x -= num; y -= num; z -= num;
+			return *this;
+		}
+		constexpr Vector_4d& operator*=(const float& num)
+		{
+			x *= num; y *= num; z *= num;
+			return *this;
+		}
+		constexpr Vector_4d& operator/=(const float& num)
+		{
+			x /= num; y /= num; z /= num;
+			return *this;
+		}
+		constexpr Vector_4d& operator+=(const Vector_4d& vec)
+		{
+			x += vec.x; y += vec.y; z += vec.z;
+			return *this;
+		}
+		constexpr Vector_4d& operator-=(const Vector_4d& vec)
+		{
+			x -= vec.x; y -= vec.y; z -= vec.z;
+			return *this;
+		}
+		constexpr Vector_4d& operator*=(const Vector_4d& vec)
+		{
+			x *= vec.x; y *= vec.y; z *= vec.z;
+			return *this;
+		}
+		constexpr Vector_4d& operator/=(const Vector_4d& vec)
+		{
+			x /= vec.x; y /= vec.y; z /= vec.z;
+			return *this;
+		}
 
-		operator Vector_3d();
+		constexpr operator Vector_3d()
+		{
+			return { x, y, z };
+		}
 	};
 
-	Vector_4d operator+(const Vector_4d& vec_a, const Vector_4d& vec_b);
-	Vector_4d operator-(const Vector_4d& vec_a, const Vector_4d& vec_b);
-	Vector_4d operator*(const Vector_4d& vec_a, const Vector_4d& vec_b);
-	Vector_4d operator/(const Vector_4d& vec_a, const Vector_4d& vec_b);
-
-	bool operator==(const Vector_4d& vec_a, const Vector_4d& vec_b);
-	bool operator!=(const Vector_4d& vec_a, const Vector_4d& vec_b);
-
-	Vector_4d operator+(const float& num, const Vector_4d& vec);
-	Vector_4d operator-(const float& num, const Vector_4d& vec);
-	Vector_4d operator*(const float& num, const Vector_4d& vec);
-	Vector_4d operator/(const float& num, const Vector_4d& vec);
-	Vector_4d operator+(const Vector_4d& vec, const float& num);
-	Vector_4d operator-(const Vector_4d& vec, const float& num);
-	Vector_4d operator*(const Vector_4d& vec, const float& num);
-	Vector_4d operator/(const Vector_4d& vec, const float& num);
+	constexpr Vector_3d::operator Vector_4d()
+	{
+		return { x, y, z, 1.0f };
+	}
+
+	constexpr Vector_4d operator+(const Vector_4d& vec_a, const Vector_4d& vec_b)
+	{
+		return { vec_a.x + vec_b.x, vec_a.y + vec_b.y, vec_a.z + vec_b.z, 1.0f };
+	}
+	constexpr Vector_4d operator-(const Vector_4d& vec_a, const Vector_4d& vec_b)
+	{
+		return { vec_a.x - vec_b.x, vec_a.y - vec_b.y, vec_a.z - vec_b.z, 1.0f };
+	}
+	constexpr Vector_4d operator*(const Vector_4d& vec_a, const Vector_4d& vec_b)
+	{
+		return { vec_a.x * vec_b.x, vec_a.y * vec_b.y, vec_a.z * vec_b.z, 1.0f };
+	}
+	constexpr Vector_4d operator/(const Vector_4d& vec_a, const Vector_4d& vec_b)
+	{
+		return { vec_a.x / vec_b.x, vec_a.y / vec_b.y, vec_a.z / vec_b.z, 1.0f };
+	}
+
+	constexpr bool operator==(const Vector_4d& vec_a, const Vector_4d& vec_b)
+	{
+		return (vec_a.x - vec_b.x) * (vec_a.x - vec_b.x) <= eps &&
+			   (vec_a.y - vec_b.y) * (vec_a.y - vec_b.y) <= eps &&
+			   (vec_a.z - vec_b.z) * (vec_a.z - vec_b.z) <= eps;
+	}
+	constexpr bool operator!=(const Vector_4d& vec_a, const Vector_4d& vec_b)
+	{
+		return !(vec_a == vec_b);
+	}
+
+	constexpr Vector_4d operator+(const float& num, const Vector_4d& vec)
+	{
+		return { num + vec.x, num + vec.y, num + vec.z, 1.0f };
+	}
+	constexpr Vector_4d operator-(const float& num, const Vector_4d& vec)
+	{
+		return { num - vec.x, num - vec.y, num - vec.z, 1.0f };
+	}
+	constexpr Vector_4d operator*(const float& num, const Vector_4d& vec)
+	{
+		return { num * vec.x, num * vec.y, num * vec.z, 1.0f };
+	}
+	constexpr Vector_4d operator/(const float& num, const Vector_4d& vec)
+	{
+		return { num / vec.x, num / vec.y, num / vec.z, 1.0f };
+	}
+	constexpr Vector_4d operator+(const Vector_4d& vec, const float& num)
+	{
+		return { vec.x + num, vec.y + num, vec.z + num, 1.0f };
+	}
+	constexpr Vector_4d operator-(const Vector_4d& vec, const float& num)
+	{
+		return { vec.x - num, vec.y - num, vec.z - num, 1.0f };
+	}
+	constexpr Vector_4d operator*(const Vector_4d& vec, const float& num)
+	{
+		return { vec.x * num, vec.y * num, vec.z * num, 1.0f };
+	}
+	constexpr Vector_4d operator/(const Vector_4d& vec, const float& num)
+	{
+		return { vec.x / num, vec.y / num, vec.z / num, 1.0f };
+	}
 }
 
@@ -0,0 +1,1000 @@
+/******************************************************************************
+	 * File: math_3d_batch.cpp
+	 * Description: Contains batch kernels over arrays of 3D/4D vectors.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include "math_3d_batch.h"
+
+#include <atomic>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MATH_3D_BATCH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// Scalar and SIMD paths must give the same bits, so no a * b + c fusing
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// MSVC allows any intrinsics in any function, GCC needs a target per function
+#if defined(_MSC_VER) && !defined(__clang__)
+#define MATH_3D_TARGET_SSE
+#define MATH_3D_TARGET_AVX2
+#else
+#define MATH_3D_TARGET_SSE __attribute__((target("sse2")))
+#define MATH_3D_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace Math_3d
+{
+	namespace Batch
+	{
+		static_assert(sizeof(Vector_3d) == 3 * sizeof(float), "Vector_3d must be tightly packed");
+		static_assert(sizeof(Vector_4d) == 4 * sizeof(float), "Vector_4d must be tightly packed");
+
+		namespace
+		{
+			std::atomic<Instruction_Set>& current_instruction_set()
+			{
+				static std::atomic<Instruction_Set> instruction_set(detect_instruction_set());
+				return instruction_set;
+			}
+
+			const float* floats(const Vector_3d* vec) { return reinterpret_cast<const float*>(vec); }
+			float* floats(Vector_3d* vec) { return reinterpret_cast<float*>(vec); }
+			const float* floats(const Vector_4d* vec) { return reinterpret_cast<const float*>(vec); }
+			float* floats(Vector_4d* vec) { return reinterpret_cast<float*>(vec); }
+
+			/**
+			 * Reference implementation, also handles tails of SIMD kernels.
+			 * SIMD kernels below repeat its operation order exactly.
+			 */
+			namespace Scalar
+			{
+				void add(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i)
+						result[i] = a[i] + b[i];
+				}
+				void sub(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i)
+						result[i] = a[i] - b[i];
+				}
+				void scale(const float* a, float num, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i)
+						result[i] = a[i] * num;
+				}
+
+				void dot_3d(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 3, b += 3)
+						result[i] = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+				}
+				void cross_3d(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 3, b += 3, result += 3)
+					{
+						float x = a[1] * b[2] - a[2] * b[1];
+						float y = a[2] * b[0] - a[0] * b[2];
+						float z = a[0] * b[1] - a[1] * b[0];
+						result[0] = x; result[1] = y; result[2] = z;
+					}
+				}
+				void normalize_3d(const float* a, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 3, result += 3)
+					{
+						float len = sqrtf(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+						float x = a[0] / len;
+						float y = a[1] / len;
+						float z = a[2] / len;
+						result[0] = x; result[1] = y; result[2] = z;
+					}
+				}
+				void distance_3d(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 3, b += 3)
+					{
+						float x = b[0] - a[0];
+						float y = b[1] - a[1];
+						float z = b[2] - a[2];
+						result[i] = sqrtf(x * x + y * y + z * z);
+					}
+				}
+
+				void add_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 4, b += 4, result += 4)
+					{
+						result[0] = a[0] + b[0]; result[1] = a[1] + b[1]; result[2] = a[2] + b[2]; result[3] = 1.0f;
+					}
+				}
+				void sub_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 4, b += 4, result += 4)
+					{
+						result[0] = a[0] - b[0]; result[1] = a[1] - b[1]; result[2] = a[2] - b[2]; result[3] = 1.0f;
+					}
+				}
+				void scale_4d(const float* a, float num, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 4, result += 4)
+					{
+						result[0] = a[0] * num; result[1] = a[1] * num; result[2] = a[2] * num; result[3] = 1.0f;
+					}
+				}
+				void dot_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 4, b += 4)
+						result[i] = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+				}
+				void cross_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 4, b += 4, result += 4)
+					{
+						float x = a[1] * b[2] - a[2] * b[1];
+						float y = a[2] * b[0] - a[0] * b[2];
+						float z = a[0] * b[1] - a[1] * b[0];
+						result[0] = x; result[1] = y; result[2] = z; result[3] = 1.0f;
+					}
+				}
+				void normalize_4d(const float* a, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 4, result += 4)
+					{
+						float len = sqrtf(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+						float x = a[0] / len;
+						float y = a[1] / len;
+						float z = a[2] / len;
+						result[0] = x; result[1] = y; result[2] = z; result[3] = a[3];
+					}
+				}
+				void distance_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 4, b += 4)
+					{
+						float x = b[0] - a[0];
+						float y = b[1] - a[1];
+						float z = b[2] - a[2];
+						float w = b[3] - a[3];
+						result[i] = sqrtf(x * x + y * y + z * z + w * w);
+					}
+				}
+
+				/**
+				 * `translate` is 1.0f for points and 0.0f for directions
+				 */
+				void transform_3d(const float* m, bool translate, const float* a, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 3, result += 3)
+					{
+						float x = a[0] * m[0] + a[1] * m[4] + a[2] * m[8];
+						float y = a[0] * m[1] + a[1] * m[5] + a[2] * m[9];
+						float z = a[0] * m[2] + a[1] * m[6] + a[2] * m[10];
+						if (translate)
+						{
+							x = x + m[12];
+							y = y + m[13];
+							z = z + m[14];
+						}
+						result[0] = x; result[1] = y; result[2] = z;
+					}
+				}
+				void transform_4d(const float* m, const float* a, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i, a += 4, result += 4)
+					{
+						float x = a[0] * m[0] + a[1] * m[4] + a[2] * m[8] + a[3] * m[12];
+						float y = a[0] * m[1] + a[1] * m[5] + a[2] * m[9] + a[3] * m[13];
+						float z = a[0] * m[2] + a[1] * m[6] + a[2] * m[10] + a[3] * m[14];
+						float w = a[0] * m[3] + a[1] * m[7] + a[2] * m[11] + a[3] * m[15];
+						result[0] = x; result[1] = y; result[2] = z; result[3] = w;
+					}
+				}
+			}
+
+#ifdef MATH_3D_BATCH_X86
+			/**
+			 * SSE kernels, 4 vectors per iteration.
+			 * Every kernel returns number of processed elements,
+			 * the rest is left for Scalar.
+			 */
+			namespace Sse
+			{
+				/**
+				 * x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3  ->  x0..x3 | y0..y3 | z0..z3
+				 */
+				MATH_3D_TARGET_SSE inline void load_3d(const float* src, __m128& x, __m128& y, __m128& z)
+				{
+					__m128 a = _mm_loadu_ps(src);
+					__m128 b = _mm_loadu_ps(src + 4);
+					__m128 c = _mm_loadu_ps(src + 8);
+
+					x = _mm_shuffle_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 3, 0, 0)),
+									   _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+					y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 0, 1)),
+									   _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 2, 0, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+					z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 1, 0, 2)),
+									   _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+				}
+				/**
+				 * Inverse of load_3d
+				 */
+				MATH_3D_TARGET_SSE inline void store_3d(float* dst, __m128 x, __m128 y, __m128 z)
+				{
+					__m128 a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+											  _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+					__m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+											  _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+					__m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+											  _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+					_mm_storeu_ps(dst, a);
+					_mm_storeu_ps(dst + 4, b);
+					_mm_storeu_ps(dst + 8, c);
+				}
+				/**
+				 * 4 rows of x y z w  ->  x0..x3 | y0..y3 | z0..z3 | w0..w3, and back
+				 */
+				MATH_3D_TARGET_SSE inline void transpose(__m128& r0, __m128& r1, __m128& r2, __m128& r3)
+				{
+					__m128 t0 = _mm_unpacklo_ps(r0, r1);
+					__m128 t1 = _mm_unpacklo_ps(r2, r3);
+					__m128 t2 = _mm_unpackhi_ps(r0, r1);
+					__m128 t3 = _mm_unpackhi_ps(r2, r3);
+					r0 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+					r1 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+					r2 = _mm_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+					r3 = _mm_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+				}
+				/**
+				 * Keep x, y, z and put 1.0f to every w
+				 */
+				MATH_3D_TARGET_SSE inline __m128 set_w_one(__m128 vec)
+				{
+					const __m128 xyz_mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+					const __m128 w_one = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+					return _mm_or_ps(_mm_and_ps(vec, xyz_mask), w_one);
+				}
+
+				MATH_3D_TARGET_SSE size_t add(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 4 <= count; i += 4)
+						_mm_storeu_ps(result + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+					return i;
+				}
+				MATH_3D_TARGET_SSE size_t sub(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 4 <= count; i += 4)
+						_mm_storeu_ps(result + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+					return i;
+				}
+				MATH_3D_TARGET_SSE size_t scale(const float* a, float num, float* result, size_t count)
+				{
+					__m128 n = _mm_set1_ps(num);
+					size_t i = 0;
+					for (; i + 4 <= count; i += 4)
+						_mm_storeu_ps(result + i, _mm_mul_ps(_mm_loadu_ps(a + i), n));
+					return i;
+				}
+
+				MATH_3D_TARGET_SSE size_t dot_3d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 4 <= count; i += 4)
+					{
+						__m128 ax, ay, az, bx, by, bz;
+						load_3d(a + i * 3, ax, ay, az);
+						load_3d(b + i * 3, bx, by, bz);
+						__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+						_mm_storeu_ps(result + i, dot);
+					}
+					return i;
+				}
+				MATH_3D_TARGET_SSE size_t cross_3d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 4 <= count; i += 4)
+					{
+						__m128 ax, ay, az, bx, by, bz;
+						load_3d(a + i * 3, ax, ay, az);
+						load_3d(b + i * 3, bx, by, bz);
+						__m128 x = _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by));
+						__m128 y = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz));
+						__m128 z = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+						store_3d(result + i * 3, x, y, z);
+					}
+					return i;
+				}
+				MATH_3D_TARGET_SSE size_t normalize_3d(const float* a, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 4 <= count; i += 4)
+					{
+						__m128 x, y, z;
+						load_3d(a + i * 3, x, y, z);
+						__m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+						store_3d(result + i * 3, _mm_div_ps(x, len), _mm_div_ps(y, len), _mm_div_ps(z, len));
+					}
+					return i;
+				}
+				MATH_3D_TARGET_SSE size_t distance_3d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 4 <= count; i += 4)
+					{
+						__m128 ax, ay, az, bx, by, bz;
+						load_3d(a + i * 3, ax, ay, az);
+						load_3d(b + i * 3, bx, by, bz);
+						__m128 x = _mm_sub_ps(bx, ax);
+						__m128 y = _mm_sub_ps(by, ay);
+						__m128 z = _mm_sub_ps(bz, az);
+						__m128 sum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+						_mm_storeu_ps(result + i, _mm_sqrt_ps(sum));
+					}
+					return i;
+				}
+
+				MATH_3D_TARGET_SSE size_t add_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i)
+						_mm_storeu_ps(result + i * 4, set_w_one(_mm_add_ps(_mm_loadu_ps(a + i * 4), _mm_loadu_ps(b + i * 4))));
+					return count;
+				}
+				MATH_3D_TARGET_SSE size_t sub_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i)
+						_mm_storeu_ps(result + i * 4, set_w_one(_mm_sub_ps(_mm_loadu_ps(a + i * 4), _mm_loadu_ps(b + i * 4))));
+					return count;
+				}
+				MATH_3D_TARGET_SSE size_t scale_4d(const float* a, float num, float* result, size_t count)
+				{
+					__m128 n = _mm_set1_ps(num);
+					for (size_t i = 0; i < count; ++i)
+						_mm_storeu_ps(result + i * 4, set_w_one(_mm_mul_ps(_mm_loadu_ps(a + i * 4), n)));
+					return count;
+				}
+				MATH_3D_TARGET_SSE size_t dot_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 4 <= count; i += 4)
+					{
+						__m128 ax = _mm_loadu_ps(a + i * 4), ay = _mm_loadu_ps(a + i * 4 + 4);
+						__m128 az = _mm_loadu_ps(a + i * 4 + 8), aw = _mm_loadu_ps(a + i * 4 + 12);
+						__m128 bx = _mm_loadu_ps(b + i * 4), by = _mm_loadu_ps(b + i * 4 + 4);
+						__m128 bz = _mm_loadu_ps(b + i * 4 + 8), bw = _mm_loadu_ps(b + i * 4 + 12);
+						transpose(ax, ay, az, aw);
+						transpose(bx, by, bz, bw);
+						__m128 dot = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+															_mm_mul_ps(az, bz)), _mm_mul_ps(aw, bw));
+						_mm_storeu_ps(result + i, dot);
+					}
+					return i;
+				}
+				MATH_3D_TARGET_SSE size_t cross_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					for (size_t i = 0; i < count; ++i)
+					{
+						__m128 va = _mm_loadu_ps(a + i * 4);
+						__m128 vb = _mm_loadu_ps(b + i * 4);
+						// a.yzx * b.zxy - a.zxy * b.yzx
+						__m128 a_yzx = _mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 0, 2, 1));
+						__m128 a_zxy = _mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 1, 0, 2));
+						__m128 b_yzx = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 0, 2, 1));
+						__m128 b_zxy = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 1, 0, 2));
+						__m128 cross = _mm_sub_ps(_mm_mul_ps(a_yzx, b_zxy), _mm_mul_ps(a_zxy, b_yzx));
+						_mm_storeu_ps(result + i * 4, set_w_one(cross));
+					}
+					return count;
+				}
+				MATH_3D_TARGET_SSE size_t normalize_4d(const float* a, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 4 <= count; i += 4)
+					{
+						__m128 x = _mm_loadu_ps(a + i * 4), y = _mm_loadu_ps(a + i * 4 + 4);
+						__m128 z = _mm_loadu_ps(a + i * 4 + 8), w = _mm_loadu_ps(a + i * 4 + 12);
+						transpose(x, y, z, w);
+						__m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+						x = _mm_div_ps(x, len);
+						y = _mm_div_ps(y, len);
+						z = _mm_div_ps(z, len);
+						transpose(x, y, z, w);
+						_mm_storeu_ps(result + i * 4, x);
+						_mm_storeu_ps(result + i * 4 + 4, y);
+						_mm_storeu_ps(result + i * 4 + 8, z);
+						_mm_storeu_ps(result + i * 4 + 12, w);
+					}
+					return i;
+				}
+				MATH_3D_TARGET_SSE size_t distance_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 4 <= count; i += 4)
+					{
+						__m128 x = _mm_sub_ps(_mm_loadu_ps(b + i * 4), _mm_loadu_ps(a + i * 4));
+						__m128 y = _mm_sub_ps(_mm_loadu_ps(b + i * 4 + 4), _mm_loadu_ps(a + i * 4 + 4));
+						__m128 z = _mm_sub_ps(_mm_loadu_ps(b + i * 4 + 8), _mm_loadu_ps(a + i * 4 + 8));
+						__m128 w = _mm_sub_ps(_mm_loadu_ps(b + i * 4 + 12), _mm_loadu_ps(a + i * 4 + 12));
+						transpose(x, y, z, w);
+						__m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+															_mm_mul_ps(z, z)), _mm_mul_ps(w, w));
+						_mm_storeu_ps(result + i, _mm_sqrt_ps(sum));
+					}
+					return i;
+				}
+
+				MATH_3D_TARGET_SSE size_t transform_3d(const float* m, bool translate, const float* a, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 4 <= count; i += 4)
+					{
+						__m128 x, y, z;
+						load_3d(a + i * 3, x, y, z);
+						__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m[0])), _mm_mul_ps(y, _mm_set1_ps(m[4]))),
+											   _mm_mul_ps(z, _mm_set1_ps(m[8])));
+						__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m[1])), _mm_mul_ps(y, _mm_set1_ps(m[5]))),
+											   _mm_mul_ps(z, _mm_set1_ps(m[9])));
+						__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m[2])), _mm_mul_ps(y, _mm_set1_ps(m[6]))),
+											   _mm_mul_ps(z, _mm_set1_ps(m[10])));
+						if (translate)
+						{
+							rx = _mm_add_ps(rx, _mm_set1_ps(m[12]));
+							ry = _mm_add_ps(ry, _mm_set1_ps(m[13]));
+							rz = _mm_add_ps(rz, _mm_set1_ps(m[14]));
+						}
+						store_3d(result + i * 3, rx, ry, rz);
+					}
+					return i;
+				}
+				MATH_3D_TARGET_SSE size_t transform_4d(const float* m, const float* a, float* result, size_t count)
+				{
+					// Row vector by matrix: broadcast components, sum matrix rows
+					__m128 m0 = _mm_loadu_ps(m);
+					__m128 m1 = _mm_loadu_ps(m + 4);
+					__m128 m2 = _mm_loadu_ps(m + 8);
+					__m128 m3 = _mm_loadu_ps(m + 12);
+					for (size_t i = 0; i < count; ++i)
+					{
+						__m128 vec = _mm_loadu_ps(a + i * 4);
+						__m128 sum = _mm_mul_ps(_mm_shuffle_ps(vec, vec, _MM_SHUFFLE(0, 0, 0, 0)), m0);
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 1, 1, 1)), m1));
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(vec, vec, _MM_SHUFFLE(2, 2, 2, 2)), m2));
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(vec, vec, _MM_SHUFFLE(3, 3, 3, 3)), m3));
+						_mm_storeu_ps(result + i * 4, sum);
+					}
+					return count;
+				}
+			}
+
+			/**
+			 * AVX2 kernels, 8 vectors per iteration.
+			 * 128-bit lanes are handled as two independent SSE blocks:
+			 * low lane takes vectors 0..3, high lane takes vectors 4..7.
+			 */
+			namespace Avx2
+			{
+				MATH_3D_TARGET_AVX2 inline __m256 load_lanes(const float* low, const float* high)
+				{
+					return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+				}
+				MATH_3D_TARGET_AVX2 inline void store_lanes(float* low, float* high, __m256 vec)
+				{
+					_mm_storeu_ps(low, _mm256_castps256_ps128(vec));
+					_mm_storeu_ps(high, _mm256_extractf128_ps(vec, 1));
+				}
+
+				/**
+				 * Same shuffles as Sse::load_3d, per lane
+				 */
+				MATH_3D_TARGET_AVX2 inline void load_3d(const float* src, __m256& x, __m256& y, __m256& z)
+				{
+					__m256 a = load_lanes(src, src + 12);
+					__m256 b = load_lanes(src + 4, src + 16);
+					__m256 c = load_lanes(src + 8, src + 20);
+
+					x = _mm256_shuffle_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(0, 3, 0, 0)),
+										  _mm256_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+					y = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 0, 1)),
+										  _mm256_shuffle_ps(b, c, _MM_SHUFFLE(0, 2, 0, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+					z = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 1, 0, 2)),
+										  _mm256_shuffle_ps(c, c, _MM_SHUFFLE(0, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+				}
+				MATH_3D_TARGET_AVX2 inline void store_3d(float* dst, __m256 x, __m256 y, __m256 z)
+				{
+					__m256 a = _mm256_shuffle_ps(_mm256_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+												 _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+					__m256 b = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+												 _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+					__m256 c = _mm256_shuffle_ps(_mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+												 _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+					store_lanes(dst, dst + 12, a);
+					store_lanes(dst + 4, dst + 16, b);
+					store_lanes(dst + 8, dst + 20, c);
+				}
+				/**
+				 * Loads 8 Vector_4d as x0..x7 | y0..y7 | z0..z7 | w0..w7
+				 */
+				MATH_3D_TARGET_AVX2 inline void load_4d(const float* src, __m256& x, __m256& y, __m256& z, __m256& w)
+				{
+					__m256 r0 = load_lanes(src, src + 16);
+					__m256 r1 = load_lanes(src + 4, src + 20);
+					__m256 r2 = load_lanes(src + 8, src + 24);
+					__m256 r3 = load_lanes(src + 12, src + 28);
+					__m256 t0 = _mm256_unpacklo_ps(r0, r1);
+					__m256 t1 = _mm256_unpacklo_ps(r2, r3);
+					__m256 t2 = _mm256_unpackhi_ps(r0, r1);
+					__m256 t3 = _mm256_unpackhi_ps(r2, r3);
+					x = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+					y = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+					z = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+					w = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+				}
+				MATH_3D_TARGET_AVX2 inline void store_4d(float* dst, __m256 x, __m256 y, __m256 z, __m256 w)
+				{
+					__m256 t0 = _mm256_unpacklo_ps(x, y);
+					__m256 t1 = _mm256_unpacklo_ps(z, w);
+					__m256 t2 = _mm256_unpackhi_ps(x, y);
+					__m256 t3 = _mm256_unpackhi_ps(z, w);
+					store_lanes(dst, dst + 16, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)));
+					store_lanes(dst + 4, dst + 20, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2)));
+					store_lanes(dst + 8, dst + 24, _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+					store_lanes(dst + 12, dst + 28, _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+				}
+				MATH_3D_TARGET_AVX2 inline __m256 set_w_one(__m256 vec)
+				{
+					const __m256 xyz_mask = _mm256_castsi256_ps(_mm256_set_epi32(0, -1, -1, -1, 0, -1, -1, -1));
+					const __m256 w_one = _mm256_set_ps(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+					return _mm256_or_ps(_mm256_and_ps(vec, xyz_mask), w_one);
+				}
+
+				MATH_3D_TARGET_AVX2 size_t add(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+						_mm256_storeu_ps(result + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t sub(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+						_mm256_storeu_ps(result + i, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t scale(const float* a, float num, float* result, size_t count)
+				{
+					__m256 n = _mm256_set1_ps(num);
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+						_mm256_storeu_ps(result + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), n));
+					return i;
+				}
+
+				MATH_3D_TARGET_AVX2 size_t dot_3d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						__m256 ax, ay, az, bx, by, bz;
+						load_3d(a + i * 3, ax, ay, az);
+						load_3d(b + i * 3, bx, by, bz);
+						__m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+						_mm256_storeu_ps(result + i, dot);
+					}
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t cross_3d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						__m256 ax, ay, az, bx, by, bz;
+						load_3d(a + i * 3, ax, ay, az);
+						load_3d(b + i * 3, bx, by, bz);
+						__m256 x = _mm256_sub_ps(_mm256_mul_ps(ay, bz), _mm256_mul_ps(az, by));
+						__m256 y = _mm256_sub_ps(_mm256_mul_ps(az, bx), _mm256_mul_ps(ax, bz));
+						__m256 z = _mm256_sub_ps(_mm256_mul_ps(ax, by), _mm256_mul_ps(ay, bx));
+						store_3d(result + i * 3, x, y, z);
+					}
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t normalize_3d(const float* a, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						__m256 x, y, z;
+						load_3d(a + i * 3, x, y, z);
+						__m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)));
+						store_3d(result + i * 3, _mm256_div_ps(x, len), _mm256_div_ps(y, len), _mm256_div_ps(z, len));
+					}
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t distance_3d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						__m256 ax, ay, az, bx, by, bz;
+						load_3d(a + i * 3, ax, ay, az);
+						load_3d(b + i * 3, bx, by, bz);
+						__m256 x = _mm256_sub_ps(bx, ax);
+						__m256 y = _mm256_sub_ps(by, ay);
+						__m256 z = _mm256_sub_ps(bz, az);
+						__m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+						_mm256_storeu_ps(result + i, _mm256_sqrt_ps(sum));
+					}
+					return i;
+				}
+
+				MATH_3D_TARGET_AVX2 size_t add_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 2 <= count; i += 2)
+						_mm256_storeu_ps(result + i * 4, set_w_one(_mm256_add_ps(_mm256_loadu_ps(a + i * 4), _mm256_loadu_ps(b + i * 4))));
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t sub_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 2 <= count; i += 2)
+						_mm256_storeu_ps(result + i * 4, set_w_one(_mm256_sub_ps(_mm256_loadu_ps(a + i * 4), _mm256_loadu_ps(b + i * 4))));
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t scale_4d(const float* a, float num, float* result, size_t count)
+				{
+					__m256 n = _mm256_set1_ps(num);
+					size_t i = 0;
+					for (; i + 2 <= count; i += 2)
+						_mm256_storeu_ps(result + i * 4, set_w_one(_mm256_mul_ps(_mm256_loadu_ps(a + i * 4), n)));
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t dot_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						__m256 ax, ay, az, aw, bx, by, bz, bw;
+						load_4d(a + i * 4, ax, ay, az, aw);
+						load_4d(b + i * 4, bx, by, bz, bw);
+						__m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)),
+																 _mm256_mul_ps(az, bz)), _mm256_mul_ps(aw, bw));
+						_mm256_storeu_ps(result + i, dot);
+					}
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t cross_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 2 <= count; i += 2)
+					{
+						__m256 va = _mm256_loadu_ps(a + i * 4);
+						__m256 vb = _mm256_loadu_ps(b + i * 4);
+						__m256 a_yzx = _mm256_shuffle_ps(va, va, _MM_SHUFFLE(3, 0, 2, 1));
+						__m256 a_zxy = _mm256_shuffle_ps(va, va, _MM_SHUFFLE(3, 1, 0, 2));
+						__m256 b_yzx = _mm256_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 0, 2, 1));
+						__m256 b_zxy = _mm256_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 1, 0, 2));
+						__m256 cross = _mm256_sub_ps(_mm256_mul_ps(a_yzx, b_zxy), _mm256_mul_ps(a_zxy, b_yzx));
+						_mm256_storeu_ps(result + i * 4, set_w_one(cross));
+					}
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t normalize_4d(const float* a, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						__m256 x, y, z, w;
+						load_4d(a + i * 4, x, y, z, w);
+						__m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)));
+						store_4d(result + i * 4, _mm256_div_ps(x, len), _mm256_div_ps(y, len), _mm256_div_ps(z, len), w);
+					}
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t distance_4d(const float* a, const float* b, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						__m256 ax, ay, az, aw, bx, by, bz, bw;
+						load_4d(a + i * 4, ax, ay, az, aw);
+						load_4d(b + i * 4, bx, by, bz, bw);
+						__m256 x = _mm256_sub_ps(bx, ax);
+						__m256 y = _mm256_sub_ps(by, ay);
+						__m256 z = _mm256_sub_ps(bz, az);
+						__m256 w = _mm256_sub_ps(bw, aw);
+						__m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)),
+																 _mm256_mul_ps(z, z)), _mm256_mul_ps(w, w));
+						_mm256_storeu_ps(result + i, _mm256_sqrt_ps(sum));
+					}
+					return i;
+				}
+
+				MATH_3D_TARGET_AVX2 size_t transform_3d(const float* m, bool translate, const float* a, float* result, size_t count)
+				{
+					size_t i = 0;
+					for (; i + 8 <= count; i += 8)
+					{
+						__m256 x, y, z;
+						load_3d(a + i * 3, x, y, z);
+						__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(m[0])), _mm256_mul_ps(y, _mm256_set1_ps(m[4]))),
+												  _mm256_mul_ps(z, _mm256_set1_ps(m[8])));
+						__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(m[1])), _mm256_mul_ps(y, _mm256_set1_ps(m[5]))),
+												  _mm256_mul_ps(z, _mm256_set1_ps(m[9])));
+						__m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(m[2])), _mm256_mul_ps(y, _mm256_set1_ps(m[6]))),
+												  _mm256_mul_ps(z, _mm256_set1_ps(m[10])));
+						if (translate)
+						{
+							rx = _mm256_add_ps(rx, _mm256_set1_ps(m[12]));
+							ry = _mm256_add_ps(ry, _mm256_set1_ps(m[13]));
+							rz = _mm256_add_ps(rz, _mm256_set1_ps(m[14]));
+						}
+						store_3d(result + i * 3, rx, ry, rz);
+					}
+					return i;
+				}
+				MATH_3D_TARGET_AVX2 size_t transform_4d(const float* m, const float* a, float* result, size_t count)
+				{
+					// Two vectors per iteration, one per lane
+					__m256 m0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m));
+					__m256 m1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 4));
+					__m256 m2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 8));
+					__m256 m3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 12));
+					size_t i = 0;
+					for (; i + 2 <= count; i += 2)
+					{
+						__m256 vec = _mm256_loadu_ps(a + i * 4);
+						__m256 sum = _mm256_mul_ps(_mm256_shuffle_ps(vec, vec, _MM_SHUFFLE(0, 0, 0, 0)), m0);
+						sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 1, 1, 1)), m1));
+						sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(vec, vec, _MM_SHUFFLE(2, 2, 2, 2)), m2));
+						sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(vec, vec, _MM_SHUFFLE(3, 3, 3, 3)), m3));
+						_mm256_storeu_ps(result + i * 4, sum);
+					}
+					return i;
+				}
+			}
+#endif
+		}
+
+// Run SIMD kernel for instruction set in use, `done` gets number of processed
+// elements and the tail is finished with Scalar by the caller.
+#ifdef MATH_3D_BATCH_X86
+#define MATH_3D_DISPATCH(kernel, done, ...)                                     \
+		switch (current_instruction_set().load(std::memory_order_relaxed))       \
+		{                                                                        \
+		case Instruction_Set::avx2: done = Avx2::kernel(__VA_ARGS__); break;     \
+		case Instruction_Set::sse:  done = Sse::kernel(__VA_ARGS__); break;      \
+		default: break;                                                          \
+		}
+#else
+#define MATH_3D_DISPATCH(kernel, done, ...)
+#endif
+
+		Instruction_Set detect_instruction_set()
+		{
+#ifdef MATH_3D_BATCH_X86
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			int max_leaf = info[0];
+
+			__cpuid(info, 1);
+			bool sse2 = (info[3] & (1 << 26)) != 0;
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+			bool avx = (info[2] & (1 << 28)) != 0;
+
+			bool avx2 = false;
+			// OS must save YMM registers on context switch
+			if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+			{
+				__cpuidex(info, 7, 0);
+				avx2 = (info[1] & (1 << 5)) != 0;
+			}
+#else
+			__builtin_cpu_init();
+			bool sse2 = __builtin_cpu_supports("sse2");
+			bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+			if (avx2)
+				return Instruction_Set::avx2;
+			if (sse2)
+				return Instruction_Set::sse;
+#endif
+			return Instruction_Set::scalar;
+		}
+
+		Instruction_Set get_instruction_set()
+		{
+			return current_instruction_set().load();
+		}
+
+		void set_instruction_set(Instruction_Set instruction_set)
+		{
+			Instruction_Set supported = detect_instruction_set();
+			if (static_cast<int>(instruction_set) > static_cast<int>(supported))
+				instruction_set = supported;
+			current_instruction_set().store(instruction_set);
+		}
+
+		void add(const Vector_3d* vec_a, const Vector_3d* vec_b, Vector_3d* result, size_t count)
+		{
+			const float* a = floats(vec_a);
+			const float* b = floats(vec_b);
+			float* r = floats(result);
+			size_t total = count * 3;
+			size_t done = 0;
+			MATH_3D_DISPATCH(add, done, a, b, r, total);
+			Scalar::add(a + done, b + done, r + done, total - done);
+		}
+
+		void sub(const Vector_3d* vec_a, const Vector_3d* vec_b, Vector_3d* result, size_t count)
+		{
+			const float* a = floats(vec_a);
+			const float* b = floats(vec_b);
+			float* r = floats(result);
+			size_t total = count * 3;
+			size_t done = 0;
+			MATH_3D_DISPATCH(sub, done, a, b, r, total);
+			Scalar::sub(a + done, b + done, r + done, total - done);
+		}
+
+		void scale(const Vector_3d* vec, float num, Vector_3d* result, size_t count)
+		{
+			const float* a = floats(vec);
+			float* r = floats(result);
+			size_t total = count * 3;
+			size_t done = 0;
+			MATH_3D_DISPATCH(scale, done, a, num, r, total);
+			Scalar::scale(a + done, num, r + done, total - done);
+		}
+
+		void dot(const Vector_3d* vec_a, const Vector_3d* vec_b, float* result, size_t count)
+		{
+			const float* a = floats(vec_a);
+			const float* b = floats(vec_b);
+			size_t done = 0;
+			MATH_3D_DISPATCH(dot_3d, done, a, b, result, count);
+			Scalar::dot_3d(a + done * 3, b + done * 3, result + done, count - done);
+		}
+
+		void cross(const Vector_3d* vec_a, const Vector_3d* vec_b, Vector_3d* result, size_t count)
+		{
+			const float* a = floats(vec_a);
+			const float* b = floats(vec_b);
+			float* r = floats(result);
+			size_t done = 0;
+			MATH_3D_DISPATCH(cross_3d, done, a, b, r, count);
+			Scalar::cross_3d(a + done * 3, b + done * 3, r + done * 3, count - done);
+		}
+
+		void normalize(const Vector_3d* vec, Vector_3d* result, size_t count)
+		{
+			const float* a = floats(vec);
+			float* r = floats(result);
+			size_t done = 0;
+			MATH_3D_DISPATCH(normalize_3d, done, a, r, count);
+			Scalar::normalize_3d(a + done * 3, r + done * 3, count - done);
+		}
+
+		void distance(const Vector_3d* vec_a, const Vector_3d* vec_b, float* result, size_t count)
+		{
+			const float* a = floats(vec_a);
+			const float* b = floats(vec_b);
+			size_t done = 0;
+			MATH_3D_DISPATCH(distance_3d, done, a, b, result, count);
+			Scalar::distance_3d(a + done * 3, b + done * 3, result + done, count - done);
+		}
+
+		void add(const Vector_4d* vec_a, const Vector_4d* vec_b, Vector_4d* result, size_t count)
+		{
+			const float* a = floats(vec_a);
+			const float* b = floats(vec_b);
+			float* r = floats(result);
+			size_t done = 0;
+			MATH_3D_DISPATCH(add_4d, done, a, b, r, count);
+			Scalar::add_4d(a + done * 4, b + done * 4, r + done * 4, count - done);
+		}
+
+		void sub(const Vector_4d* vec_a, const Vector_4d* vec_b, Vector_4d* result, size_t count)
+		{
+			const float* a = floats(vec_a);
+			const float* b = floats(vec_b);
+			float* r = floats(result);
+			size_t done = 0;
+			MATH_3D_DISPATCH(sub_4d, done, a, b, r, count);
+			Scalar::sub_4d(a + done * 4, b + done * 4, r + done * 4, count - done);
+		}
+
+		void scale(const Vector_4d* vec, float num, Vector_4d* result, size_t count)
+		{
+			const float* a = floats(vec);
+			float* r = floats(result);
+			size_t done = 0;
+			MATH_3D_DISPATCH(scale_4d, done, a, num, r, count);
+			Scalar::scale_4d(a + done * 4, num, r + done * 4, count - done);
+		}
+
+		void dot(const Vector_4d* vec_a, const Vector_4d* vec_b, float* result, size_t count)
+		{
+			const float* a = floats(vec_a);
+			const float* b = floats(vec_b);
+			size_t done = 0;
+			MATH_3D_DISPATCH(dot_4d, done, a, b, result, count);
+			Scalar::dot_4d(a + done * 4, b + done * 4, result + done, count - done);
+		}
+
+		void cross(const Vector_4d* vec_a, const Vector_4d* vec_b, Vector_4d* result, size_t count)
+		{
+			const float* a = floats(vec_a);
+			const float* b = floats(vec_b);
+			float* r = floats(result);
+			size_t done = 0;
+			MATH_3D_DISPATCH(cross_4d, done, a, b, r, count);
+			Scalar::cross_4d(a + done * 4, b + done * 4, r + done * 4, count - done);
+		}
+
+		void normalize(const Vector_4d* vec, Vector_4d* result, size_t count)
+		{
+			const float* a = floats(vec);
+			float* r = floats(result);
+			size_t done = 0;
+			MATH_3D_DISPATCH(normalize_4d, done, a, r, count);
+			Scalar::normalize_4d(a + done * 4, r + done * 4, count - done);
+		}
+
+		void distance(const Vector_4d* vec_a, const Vector_4d* vec_b, float* result, size_t count)
+		{
+			const float* a = floats(vec_a);
+			const float* b = floats(vec_b);
+			size_t done = 0;
+			MATH_3D_DISPATCH(distance_4d, done, a, b, result, count);
+			Scalar::distance_4d(a + done * 4, b + done * 4, result + done, count - done);
+		}
+
+		void transform_points(const Matrix_4x4& mat, const Vector_3d* vec, Vector_3d* result, size_t count)
+		{
+			const float* a = floats(vec);
+			float* r = floats(result);
+			size_t done = 0;
+			MATH_3D_DISPATCH(transform_3d, done, mat.data(), true, a, r, count);
+			Scalar::transform_3d(mat.data(), true, a + done * 3, r + done * 3, count - done);
+		}
+
+		void transform_vectors(const Matrix_4x4& mat, const Vector_3d* vec, Vector_3d* result, size_t count)
+		{
+			const float* a = floats(vec);
+			float* r = floats(result);
+			size_t done = 0;
+			MATH_3D_DISPATCH(transform_3d, done, mat.data(), false, a, r, count);
+			Scalar::transform_3d(mat.data(), false, a + done * 3, r + done * 3, count - done);
+		}
+
+		void transform(const Matrix_4x4& mat, const Vector_4d* vec, Vector_4d* result, size_t count)
+		{
+			const float* a = floats(vec);
+			float* r = floats(result);
+			size_t done = 0;
+			MATH_3D_DISPATCH(transform_4d, done, mat.data(), a, r, count);
+			Scalar::transform_4d(mat.data(), a + done * 4, r + done * 4, count - done);
+		}
+
+#undef MATH_3D_DISPATCH
+	}
+}
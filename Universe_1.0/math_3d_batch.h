@@ -0,0 +1,90 @@
+/******************************************************************************
+	 * File: math_3d_batch.h
+	 * Description: Contains batch kernels over arrays of 3D/4D vectors.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+
+#include "math_3d.h"
+#include "math_3d_matrix.h"
+
+namespace Math_3d
+{
+	/**
+	 * Batch kernels.
+	 * Each function processes `count` vectors per call. Implementation
+	 * (scalar, SSE or AVX2) is picked at runtime from CPU features.
+	 * All implementations give bit-identical results: math is done in
+	 * float with the same operation order, without FMA contraction.
+	 * Note: unlike Vector_3d::length and distance, batch kernels do not
+	 * widen to double.
+	 * Output may alias input only exactly (result == vec_a), not partially.
+	 */
+	namespace Batch
+	{
+		enum class Instruction_Set
+		{
+			scalar,
+			sse,
+			avx2
+		};
+
+		/**
+		 * Best instruction set supported by CPU and OS
+		 */
+		Instruction_Set detect_instruction_set();
+		Instruction_Set get_instruction_set();
+		/**
+		 * Force kernels implementation, e.g. for benchmarking.
+		 * Request is clamped to detect_instruction_set().
+		 */
+		void set_instruction_set(Instruction_Set instruction_set);
+
+		void add(const Vector_3d* vec_a, const Vector_3d* vec_b, Vector_3d* result, size_t count);
+		void sub(const Vector_3d* vec_a, const Vector_3d* vec_b, Vector_3d* result, size_t count);
+		void scale(const Vector_3d* vec, float num, Vector_3d* result, size_t count);
+		/**
+		 * result[i] = vec_a[i] & vec_b[i]
+		 */
+		void dot(const Vector_3d* vec_a, const Vector_3d* vec_b, float* result, size_t count);
+		/**
+		 * result[i] = vec_a[i] ^ vec_b[i]
+		 */
+		void cross(const Vector_3d* vec_a, const Vector_3d* vec_b, Vector_3d* result, size_t count);
+		void normalize(const Vector_3d* vec, Vector_3d* result, size_t count);
+		void distance(const Vector_3d* vec_a, const Vector_3d* vec_b, float* result, size_t count);
+
+		/**
+		 * Vector_4d kernels follow Vector_4d operators:
+		 * add, sub, scale and cross work on x, y, z and set w to 1.0f,
+		 * normalize divides x, y, z by their length and keeps w,
+		 * dot and distance use all four components.
+		 */
+		void add(const Vector_4d* vec_a, const Vector_4d* vec_b, Vector_4d* result, size_t count);
+		void sub(const Vector_4d* vec_a, const Vector_4d* vec_b, Vector_4d* result, size_t count);
+		void scale(const Vector_4d* vec, float num, Vector_4d* result, size_t count);
+		void dot(const Vector_4d* vec_a, const Vector_4d* vec_b, float* result, size_t count);
+		void cross(const Vector_4d* vec_a, const Vector_4d* vec_b, Vector_4d* result, size_t count);
+		void normalize(const Vector_4d* vec, Vector_4d* result, size_t count);
+		void distance(const Vector_4d* vec_a, const Vector_4d* vec_b, float* result, size_t count);
+
+		/**
+		 * result[i] = transform_point(vec[i], mat)
+		 */
+		void transform_points(const Matrix_4x4& mat, const Vector_3d* vec, Vector_3d* result, size_t count);
+		/**
+		 * result[i] = transform_vector(vec[i], mat)
+		 */
+		void transform_vectors(const Matrix_4x4& mat, const Vector_3d* vec, Vector_3d* result, size_t count);
+		/**
+		 * result[i] = vec[i] * mat
+		 */
+		void transform(const Matrix_4x4& mat, const Vector_4d* vec, Vector_4d* result, size_t count);
+	}
+}
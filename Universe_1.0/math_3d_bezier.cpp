@@ -0,0 +1,213 @@
+/******************************************************************************
+	 * File: math_3d_bezier.cpp
+	 * Description: Contains Bezier curve evaluation for 3D.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include "math_3d_bezier.h"
+
+namespace Math_3d
+{
+	namespace
+	{
+		struct Point_3d
+		{
+			double x = 0.0;
+			double y = 0.0;
+			double z = 0.0;
+		};
+
+		/**
+		 * Row n of Pascal triangle
+		 */
+		std::vector<double> make_binomials(int n)
+		{
+			std::vector<double> result(n + 1, 1.0);
+			for (int i = 1; i < n; ++i)
+			{
+				result[i] = result[i - 1] * static_cast<double>(n - i + 1) / static_cast<double>(i);
+			}
+			return result;
+		}
+
+		/**
+		 * For t <= 0.5: B(t) = (1 - t)^n * sum(C(n, i) * P[i] * u^i), u = t / (1 - t),
+		 * for t > 0.5 the same, mirrored, so u never exceeds 1
+		 */
+		Point_3d evaluate_horner(const std::vector<Vector_3d>& points, const std::vector<double>& binomials, double t)
+		{
+			const int n = static_cast<int>(points.size()) - 1;
+			Point_3d result;
+			if (t <= 0.5)
+			{
+				double u = t / (1.0 - t);
+				for (int i = n; i >= 0; --i)
+				{
+					result.x = result.x * u + binomials[i] * points[i].x;
+					result.y = result.y * u + binomials[i] * points[i].y;
+					result.z = result.z * u + binomials[i] * points[i].z;
+				}
+				double scale = pow(1.0 - t, n);
+				result.x *= scale;
+				result.y *= scale;
+				result.z *= scale;
+			}
+			else
+			{
+				double u = (1.0 - t) / t;
+				for (int i = 0; i <= n; ++i)
+				{
+					result.x = result.x * u + binomials[i] * points[i].x;
+					result.y = result.y * u + binomials[i] * points[i].y;
+					result.z = result.z * u + binomials[i] * points[i].z;
+				}
+				double scale = pow(t, n);
+				result.x *= scale;
+				result.y *= scale;
+				result.z *= scale;
+			}
+			return result;
+		}
+
+		Point_3d evaluate_de_casteljau(const std::vector<Vector_3d>& points, double t)
+		{
+			std::vector<Point_3d> work(points.size());
+			for (size_t i = 0; i < points.size(); ++i)
+			{
+				work[i] = { points[i].x, points[i].y, points[i].z };
+			}
+			for (size_t level = points.size() - 1; level > 0; --level)
+			{
+				for (size_t i = 0; i < level; ++i)
+				{
+					work[i].x += (work[i + 1].x - work[i].x) * t;
+					work[i].y += (work[i + 1].y - work[i].y) * t;
+					work[i].z += (work[i + 1].z - work[i].z) * t;
+				}
+			}
+			return work[0];
+		}
+
+		Point_3d evaluate(const std::vector<Vector_3d>& points, const std::vector<double>& binomials, double t)
+		{
+			if (points.empty())
+			{
+				return Point_3d();
+			}
+			if (static_cast<int>(points.size()) - 1 > Bezier::horner_max_degree)
+			{
+				return evaluate_de_casteljau(points, t);
+			}
+			return evaluate_horner(points, binomials, t);
+		}
+
+		Vector_3d to_vector_3d(const Point_3d& point)
+		{
+			return { static_cast<float>(point.x), static_cast<float>(point.y), static_cast<float>(point.z) };
+		}
+
+		void sample_curve(const std::vector<Vector_3d>& points, const std::vector<double>& binomials,
+						  float t0, float t1, size_t count, Vector_3d* out)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+			if (count == 1)
+			{
+				out[0] = to_vector_3d(evaluate(points, binomials, t0));
+				return;
+			}
+
+			const int n = static_cast<int>(points.size()) - 1;
+			const double delta = (static_cast<double>(t1) - static_cast<double>(t0)) / static_cast<double>(count - 1);
+			if (n < 0 || n > Bezier::forward_difference_max_degree)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					out[i] = to_vector_3d(evaluate(points, binomials, t0 + delta * static_cast<double>(i)));
+				}
+				return;
+			}
+
+			// Curve is polynomial of degree n in sample index, so its
+			// n-th difference is constant: start from n + 1 exact points,
+			// then each sample costs n additions per coordinate
+			Point_3d differences[Bezier::forward_difference_max_degree + 1];
+			for (int k = 0; k <= n; ++k)
+			{
+				differences[k] = evaluate(points, binomials, t0 + delta * static_cast<double>(k));
+			}
+			for (int level = 1; level <= n; ++level)
+			{
+				for (int k = n; k >= level; --k)
+				{
+					differences[k].x -= differences[k - 1].x;
+					differences[k].y -= differences[k - 1].y;
+					differences[k].z -= differences[k - 1].z;
+				}
+			}
+			for (size_t i = 0; i < count; ++i)
+			{
+				out[i] = to_vector_3d(differences[0]);
+				for (int k = 0; k < n; ++k)
+				{
+					differences[k].x += differences[k + 1].x;
+					differences[k].y += differences[k + 1].y;
+					differences[k].z += differences[k + 1].z;
+				}
+			}
+		}
+	}
+
+	Bezier::Bezier(std::vector<Vector_3d> control_points)
+	: control_points(control_points)
+	{
+		int n = degree();
+		if (n < 0)
+		{
+			return;
+		}
+		binomials = make_binomials(n);
+
+		// B'(t) = n * sum(C(n - 1, i) * (P[i + 1] - P[i]) * b(t))
+		if (n > 0)
+		{
+			derivative_binomials = make_binomials(n - 1);
+			derivative_points.reserve(n);
+			for (int i = 0; i < n; ++i)
+			{
+				derivative_points.push_back((this->control_points[i + 1] - this->control_points[i]) * static_cast<float>(n));
+			}
+		}
+	}
+
+	int Bezier::degree() const
+	{
+		return static_cast<int>(control_points.size()) - 1;
+	}
+
+	Vector_3d Bezier::get_point(float t) const
+	{
+		return to_vector_3d(evaluate(control_points, binomials, t));
+	}
+
+	Vector_3d Bezier::get_tangent(float t) const
+	{
+		return to_vector_3d(evaluate(derivative_points, derivative_binomials, t));
+	}
+
+	void Bezier::sample(float t0, float t1, size_t count, Vector_3d* out) const
+	{
+		sample_curve(control_points, binomials, t0, t1, count, out);
+	}
+
+	void Bezier::sample_tangents(float t0, float t1, size_t count, Vector_3d* out) const
+	{
+		sample_curve(derivative_points, derivative_binomials, t0, t1, count, out);
+	}
+}
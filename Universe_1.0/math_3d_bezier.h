@@ -0,0 +1,73 @@
+/******************************************************************************
+	 * File: math_3d_bezier.h
+	 * Description: Contains Bezier curve evaluation for 3D.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <vector>
+
+#include "math_3d.h"
+
+namespace Math_3d
+{
+	/**
+	* @class Bezier
+	* Bezier curve of any degree.
+	* Binomial coefficients are computed once (in double, no factorials),
+	* points are evaluated in Horner form, O(n) per point. Degrees where
+	* binomials overflow double fall back to de Casteljau, O(n^2).
+	* Math is done in double, results are rounded to float.
+	*/
+	class Bezier
+	{
+		std::vector<Vector_3d> control_points;
+		std::vector<double> binomials;
+		/**
+		 * Hodograph: derivative curve of degree n - 1
+		 */
+		std::vector<Vector_3d> derivative_points;
+		std::vector<double> derivative_binomials;
+
+	public:
+		/**
+		 * Degrees above it are evaluated by de Casteljau,
+		 * C(1030, 515) does not fit double
+		 */
+		static const int horner_max_degree = 1000;
+		/**
+		 * sample() uses forward differencing up to this degree,
+		 * it accumulates error ~ count^degree * double eps
+		 */
+		static const int forward_difference_max_degree = 3;
+
+		Bezier() {};
+		Bezier(std::vector<Vector_3d> control_points);
+
+		/**
+		 * Number of control points - 1, -1 for empty curve
+		 */
+		int degree() const;
+
+		Vector_3d get_point(float t) const;
+		/**
+		 * Derivative by t, not normalized
+		 */
+		Vector_3d get_tangent(float t) const;
+
+		/**
+		 * out[i] = get_point(t0 + i * (t1 - t0) / (count - 1)),
+		 * forward differencing for low degrees
+		 */
+		void sample(float t0, float t1, size_t count, Vector_3d* out) const;
+		/**
+		 * out[i] = get_tangent(t0 + i * (t1 - t0) / (count - 1))
+		 */
+		void sample_tangents(float t0, float t1, size_t count, Vector_3d* out) const;
+	};
+}
@@ -0,0 +1,455 @@
+/******************************************************************************
+	 * File: math_3d_expr.h
+	 * Description: Contains header-only constexpr vectors with expression templates.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+
+#include "math_3d.h"
+
+namespace Math_3d
+{
+	/**
+	 * Header-only constexpr counterpart of Math_3d.
+	 * Operators on vectors do not compute anything, they build
+	 * expression nodes. Assigning an expression to Vector evaluates
+	 * it in one loop over components, so
+	 *   Vector_3 pos = center + dir * length + offset;
+	 * makes no temporaries. Everything works in constant expressions,
+	 * where const_length, const_distance and const_normalize replace
+	 * sqrtf based length, distance and normalize.
+	 * Note: do not keep expressions in `auto` variables, they refer
+	 * to their operands and can outlive them.
+	 */
+	namespace Expr
+	{
+		/**
+		 * Compile time math, computed in double.
+		 * Exact enough for tables, too slow for runtime loops.
+		 */
+		constexpr double const_abs(double num)
+		{
+			return num < 0.0 ? -num : num;
+		}
+
+		/**
+		 * Square root by Newton iterations, 0 for num <= 0
+		 */
+		constexpr double const_sqrt(double num)
+		{
+			if (num <= 0.0)
+				return 0.0;
+
+			double result = num > 1.0 ? num : 1.0;
+			for (int i = 0; i < 128; ++i)
+			{
+				double next = 0.5 * (result + num / result);
+				if (next >= result)
+					break;
+				result = next;
+			}
+			return result;
+		}
+
+		/**
+		 * Sine by Taylor series after reduction to [-pi, pi]
+		 */
+		constexpr double const_sin(double radian)
+		{
+			const double two_pi = 6.283185307179586476925;
+			const double pi_d = 3.141592653589793238463;
+
+			double turns = radian / two_pi;
+			long long whole = static_cast<long long>(turns < 0.0 ? turns - 0.5 : turns + 0.5);
+			double x = radian - static_cast<double>(whole) * two_pi;
+			if (x > pi_d)
+				x -= two_pi;
+			if (x < -pi_d)
+				x += two_pi;
+
+			double term = x;
+			double result = x;
+			for (int i = 1; i < 32 && const_abs(term) > 1e-18; ++i)
+			{
+				term *= -x * x / static_cast<double>((2 * i) * (2 * i + 1));
+				result += term;
+			}
+			return result;
+		}
+
+		constexpr double const_cos(double radian)
+		{
+			return const_sin(radian + 1.570796326794896619231);
+		}
+
+		constexpr double const_degree_to_radian(double degree)
+		{
+			return degree * 3.141592653589793238463 / 180.0;
+		}
+
+		/**
+		* @struct Vector_Expr
+		* CRTP base of every vector expression of N components.
+		*/
+		template<class E, int N>
+		struct Vector_Expr
+		{
+			static constexpr int size = N;
+
+			constexpr const E& self() const
+			{
+				return static_cast<const E&>(*this);
+			}
+
+			constexpr float operator[](int i) const
+			{
+				return self()[i];
+			}
+		};
+
+		/**
+		* @struct Vector
+		* Vector of N float components, evaluates expressions.
+		*/
+		template<int N>
+		struct Vector : Vector_Expr<Vector<N>, N>
+		{
+			float data[N] = {};
+
+			constexpr Vector() {};
+
+			template<class... T>
+			constexpr Vector(float first, T... rest) : data{ first, static_cast<float>(rest)... }
+			{
+				static_assert(sizeof...(rest) + 1 == N, "Wrong number of components");
+			}
+
+			Vector(const Vector_3d& vec) : data{ vec.x, vec.y, vec.z }
+			{
+				static_assert(N == 3, "Vector_3d converts to Vector<3> only");
+			}
+
+			Vector(const Vector_4d& vec) : data{ vec.x, vec.y, vec.z, vec.w }
+			{
+				static_assert(N == 4, "Vector_4d converts to Vector<4> only");
+			}
+
+			constexpr Vector(const Vector& vec) = default;
+
+			/**
+			 * The only place where expressions are computed
+			 */
+			template<class E>
+			constexpr Vector(const Vector_Expr<E, N>& expr)
+			{
+				for (int i = 0; i < N; ++i)
+					data[i] = expr[i];
+			}
+
+			constexpr Vector& operator=(const Vector& vec) = default;
+
+			template<class E>
+			constexpr Vector& operator=(const Vector_Expr<E, N>& expr)
+			{
+				// Components are independent, so expr may use *this
+				for (int i = 0; i < N; ++i)
+					data[i] = expr[i];
+				return *this;
+			}
+			template<class E>
+			constexpr Vector& operator+=(const Vector_Expr<E, N>& expr)
+			{
+				for (int i = 0; i < N; ++i)
+					data[i] += expr[i];
+				return *this;
+			}
+			template<class E>
+			constexpr Vector& operator-=(const Vector_Expr<E, N>& expr)
+			{
+				for (int i = 0; i < N; ++i)
+					data[i] -= expr[i];
+				return *this;
+			}
+			constexpr Vector& operator*=(float num)
+			{
+				for (int i = 0; i < N; ++i)
+					data[i] *= num;
+				return *this;
+			}
+			constexpr Vector& operator/=(float num)
+			{
+				for (int i = 0; i < N; ++i)
+					data[i] /= num;
+				return *this;
+			}
+
+			constexpr float operator[](int i) const { return data[i]; }
+			constexpr float& operator[](int i) { return data[i]; }
+
+			constexpr float x() const { return data[0]; }
+			constexpr float y() const { return data[1]; }
+			constexpr float z() const { return data[2]; }
+			constexpr float w() const { return data[3]; }
+		};
+
+		using Vector_2 = Vector<2>;
+		using Vector_3 = Vector<3>;
+		using Vector_4 = Vector<4>;
+
+		/**
+		 * Vectors are kept in expressions by reference,
+		 * expression nodes are small and kept by value.
+		 */
+		template<class E>
+		struct Operand
+		{
+			using type = const E;
+		};
+		template<int N>
+		struct Operand<Vector<N>>
+		{
+			using type = const Vector<N>&;
+		};
+
+		struct Add { static constexpr float apply(float a, float b) { return a + b; } };
+		struct Sub { static constexpr float apply(float a, float b) { return a - b; } };
+		struct Mul { static constexpr float apply(float a, float b) { return a * b; } };
+		struct Div { static constexpr float apply(float a, float b) { return a / b; } };
+		/**
+		 * For num - vec and num / vec
+		 */
+		struct Reverse_Sub { static constexpr float apply(float a, float b) { return b - a; } };
+		struct Reverse_Div { static constexpr float apply(float a, float b) { return b / a; } };
+
+		/**
+		* @struct Binary_Expr
+		* Component-wise vec_a (op) vec_b
+		*/
+		template<class L, class R, class Op, int N>
+		struct Binary_Expr : Vector_Expr<Binary_Expr<L, R, Op, N>, N>
+		{
+			typename Operand<L>::type left;
+			typename Operand<R>::type right;
+
+			constexpr Binary_Expr(const L& left, const R& right) : left(left), right(right) {};
+
+			constexpr float operator[](int i) const
+			{
+				return Op::apply(left[i], right[i]);
+			}
+		};
+
+		/**
+		* @struct Scalar_Expr
+		* Component-wise vec (op) num
+		*/
+		template<class E, class Op, int N>
+		struct Scalar_Expr : Vector_Expr<Scalar_Expr<E, Op, N>, N>
+		{
+			typename Operand<E>::type vec;
+			float num;
+
+			constexpr Scalar_Expr(const E& vec, float num) : vec(vec), num(num) {};
+
+			constexpr float operator[](int i) const
+			{
+				return Op::apply(vec[i], num);
+			}
+		};
+
+		/**
+		* @struct Ref_3d
+		* Math_3d::Vector_3d as expression operand
+		*/
+		struct Ref_3d : Vector_Expr<Ref_3d, 3>
+		{
+			const Vector_3d& vec;
+
+			explicit Ref_3d(const Vector_3d& vec) : vec(vec) {};
+
+			float operator[](int i) const
+			{
+				return i == 0 ? vec.x : (i == 1 ? vec.y : vec.z);
+			}
+		};
+
+		inline Ref_3d ref(const Vector_3d& vec)
+		{
+			return Ref_3d(vec);
+		}
+
+		template<class L, class R, int N>
+		constexpr Binary_Expr<L, R, Add, N> operator+(const Vector_Expr<L, N>& vec_a, const Vector_Expr<R, N>& vec_b)
+		{
+			return { vec_a.self(), vec_b.self() };
+		}
+		template<class L, class R, int N>
+		constexpr Binary_Expr<L, R, Sub, N> operator-(const Vector_Expr<L, N>& vec_a, const Vector_Expr<R, N>& vec_b)
+		{
+			return { vec_a.self(), vec_b.self() };
+		}
+		template<class L, class R, int N>
+		constexpr Binary_Expr<L, R, Mul, N> operator*(const Vector_Expr<L, N>& vec_a, const Vector_Expr<R, N>& vec_b)
+		{
+			return { vec_a.self(), vec_b.self() };
+		}
+		template<class L, class R, int N>
+		constexpr Binary_Expr<L, R, Div, N> operator/(const Vector_Expr<L, N>& vec_a, const Vector_Expr<R, N>& vec_b)
+		{
+			return { vec_a.self(), vec_b.self() };
+		}
+
+		template<class E, int N>
+		constexpr Scalar_Expr<E, Add, N> operator+(const Vector_Expr<E, N>& vec, float num)
+		{
+			return { vec.self(), num };
+		}
+		template<class E, int N>
+		constexpr Scalar_Expr<E, Sub, N> operator-(const Vector_Expr<E, N>& vec, float num)
+		{
+			return { vec.self(), num };
+		}
+		template<class E, int N>
+		constexpr Scalar_Expr<E, Mul, N> operator*(const Vector_Expr<E, N>& vec, float num)
+		{
+			return { vec.self(), num };
+		}
+		template<class E, int N>
+		constexpr Scalar_Expr<E, Div, N> operator/(const Vector_Expr<E, N>& vec, float num)
+		{
+			return { vec.self(), num };
+		}
+		template<class E, int N>
+		constexpr Scalar_Expr<E, Add, N> operator+(float num, const Vector_Expr<E, N>& vec)
+		{
+			return { vec.self(), num };
+		}
+		template<class E, int N>
+		constexpr Scalar_Expr<E, Reverse_Sub, N> operator-(float num, const Vector_Expr<E, N>& vec)
+		{
+			return { vec.self(), num };
+		}
+		template<class E, int N>
+		constexpr Scalar_Expr<E, Mul, N> operator*(float num, const Vector_Expr<E, N>& vec)
+		{
+			return { vec.self(), num };
+		}
+		template<class E, int N>
+		constexpr Scalar_Expr<E, Reverse_Div, N> operator/(float num, const Vector_Expr<E, N>& vec)
+		{
+			return { vec.self(), num };
+		}
+		template<class E, int N>
+		constexpr Scalar_Expr<E, Mul, N> operator-(const Vector_Expr<E, N>& vec)
+		{
+			return { vec.self(), -1.0f };
+		}
+
+		/**
+		 * Reductions and non component-wise operations
+		 * are computed right away
+		 */
+		template<class L, class R, int N>
+		constexpr float dot(const Vector_Expr<L, N>& vec_a, const Vector_Expr<R, N>& vec_b)
+		{
+			float result = 0.0f;
+			for (int i = 0; i < N; ++i)
+				result += vec_a[i] * vec_b[i];
+			return result;
+		}
+
+		/**
+		 * Runtime length, distance and normalize use sqrtf
+		 */
+		template<class E, int N>
+		inline float length(const Vector_Expr<E, N>& vec)
+		{
+			return sqrtf(dot(vec, vec));
+		}
+
+		template<class L, class R, int N>
+		inline float distance(const Vector_Expr<L, N>& vec_a, const Vector_Expr<R, N>& vec_b)
+		{
+			return length(vec_a - vec_b);
+		}
+
+		template<class E, int N>
+		inline Vector<N> normalize(const Vector_Expr<E, N>& vec)
+		{
+			Vector<N> result(vec);
+			result /= length(result);
+			return result;
+		}
+
+		/**
+		 * Same in constant expressions, via const_sqrt
+		 */
+		template<class E, int N>
+		constexpr float const_length(const Vector_Expr<E, N>& vec)
+		{
+			return static_cast<float>(const_sqrt(static_cast<double>(dot(vec, vec))));
+		}
+
+		template<class L, class R, int N>
+		constexpr float const_distance(const Vector_Expr<L, N>& vec_a, const Vector_Expr<R, N>& vec_b)
+		{
+			return const_length(vec_a - vec_b);
+		}
+
+		template<class E, int N>
+		constexpr Vector<N> const_normalize(const Vector_Expr<E, N>& vec)
+		{
+			Vector<N> result(vec);
+			result /= const_length(result);
+			return result;
+		}
+
+		template<class L, class R>
+		constexpr Vector<3> cross(const Vector_Expr<L, 3>& vec_a, const Vector_Expr<R, 3>& vec_b)
+		{
+			return { vec_a[1] * vec_b[2] - vec_a[2] * vec_b[1],
+					 vec_a[2] * vec_b[0] - vec_a[0] * vec_b[2],
+					 vec_a[0] * vec_b[1] - vec_a[1] * vec_b[0] };
+		}
+
+		template<class E>
+		Vector_3d to_vector_3d(const Vector_Expr<E, 3>& vec)
+		{
+			return { vec[0], vec[1], vec[2] };
+		}
+
+		template<class E>
+		Vector_4d to_vector_4d(const Vector_Expr<E, 4>& vec)
+		{
+			return { vec[0], vec[1], vec[2], vec[3] };
+		}
+
+		/**
+		* @struct Unit_Circle
+		* cos / sin of Count angles going around the circle
+		* from start_angle (degrees). Built at compile time
+		* for ring profiles of fixed size.
+		*/
+		template<int Count>
+		struct Unit_Circle
+		{
+			float cos_value[Count] = {};
+			float sin_value[Count] = {};
+
+			constexpr Unit_Circle(double start_angle = 0.0)
+			{
+				for (int i = 0; i < Count; ++i)
+				{
+					double angle = const_degree_to_radian(start_angle + 360.0 * i / Count);
+					cos_value[i] = static_cast<float>(const_cos(angle));
+					sin_value[i] = static_cast<float>(const_sin(angle));
+				}
+			}
+		};
+	}
+}
@@ -0,0 +1,187 @@
+/******************************************************************************
+	 * File: math_3d_frustum.cpp
+	 * Description: Contains view frustum planes and visibility tests.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <math.h>
+
+#include "math_3d_frustum.h"
+
+// Same check as in math_3d_matrix.cpp
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MATH_3D_FRUSTUM_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Math_3d
+{
+	void Box_Batch::clear()
+	{
+		center_x.clear();
+		center_y.clear();
+		center_z.clear();
+		extent_x.clear();
+		extent_y.clear();
+		extent_z.clear();
+	}
+
+	void Box_Batch::push_back(const Vector_3d& low, const Vector_3d& high)
+	{
+		center_x.push_back((low.x + high.x) * 0.5f);
+		center_y.push_back((low.y + high.y) * 0.5f);
+		center_z.push_back((low.z + high.z) * 0.5f);
+		extent_x.push_back((high.x - low.x) * 0.5f);
+		extent_y.push_back((high.y - low.y) * 0.5f);
+		extent_z.push_back((high.z - low.z) * 0.5f);
+	}
+
+	void Box_Batch::push_back(const Vector_3d& low, const Vector_3d& high, const Matrix_4x4& world)
+	{
+		// Center moves as point, half sizes add up by absolute values
+		// of matrix rows (Arvo, Graphics Gems, 1990)
+		const float (&m)[4][4] = world.m;
+		const float center[3] = { (low.x + high.x) * 0.5f, (low.y + high.y) * 0.5f, (low.z + high.z) * 0.5f };
+		const float extent[3] = { (high.x - low.x) * 0.5f, (high.y - low.y) * 0.5f, (high.z - low.z) * 0.5f };
+		float moved_center[3], moved_extent[3];
+		for (int j = 0; j < 3; ++j)
+		{
+			moved_center[j] = m[3][j];
+			moved_extent[j] = 0.0f;
+			for (int i = 0; i < 3; ++i)
+			{
+				moved_center[j] += center[i] * m[i][j];
+				moved_extent[j] += extent[i] * fabsf(m[i][j]);
+			}
+		}
+		center_x.push_back(moved_center[0]);
+		center_y.push_back(moved_center[1]);
+		center_z.push_back(moved_center[2]);
+		extent_x.push_back(moved_extent[0]);
+		extent_y.push_back(moved_extent[1]);
+		extent_z.push_back(moved_extent[2]);
+	}
+
+	Frustum::Frustum(const Matrix_4x4& view_projection)
+	{
+		// Clip = v * M, so planes are sums of matrix columns (Gribb, Hartmann, 2001)
+		// Vector_4d operators treat w as point coordinate, so sums are written out
+		const float (&m)[4][4] = view_projection.m;
+		auto combine = [&m](int j, float sign, float w_weight) -> Vector_4d
+		{
+			return Vector_4d(m[0][3] * w_weight + m[0][j] * sign, m[1][3] * w_weight + m[1][j] * sign,
+							 m[2][3] * w_weight + m[2][j] * sign, m[3][3] * w_weight + m[3][j] * sign);
+		};
+		planes[plane_left] = combine(0, 1.0f, 1.0f);
+		planes[plane_right] = combine(0, -1.0f, 1.0f);
+		planes[plane_bottom] = combine(1, 1.0f, 1.0f);
+		planes[plane_top] = combine(1, -1.0f, 1.0f);
+		planes[plane_near] = combine(2, 1.0f, 0.0f);
+		planes[plane_far] = combine(2, -1.0f, 1.0f);
+		for (Vector_4d& plane : planes)
+		{
+			const float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+			if (length > 0.0f)
+			{
+				plane.x /= length;
+				plane.y /= length;
+				plane.z /= length;
+				plane.w /= length;
+			}
+		}
+	}
+
+	bool Frustum::intersects_sphere(const Vector_3d& center, float radius) const
+	{
+		for (const Vector_4d& plane : planes)
+		{
+			if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	size_t Frustum::cull_boxes(const Box_Batch& boxes, uint32_t* visible) const
+	{
+		// Box is outside of plane if its nearest corner is: n * c + w + |n| * e < 0
+		const size_t count = boxes.size();
+		size_t visible_number = 0;
+		size_t i = 0;
+#ifdef MATH_3D_FRUSTUM_SSE
+		__m128 plane_x[planes_number], plane_y[planes_number], plane_z[planes_number], plane_w[planes_number];
+		__m128 abs_x[planes_number], abs_y[planes_number], abs_z[planes_number];
+		for (int p = 0; p < planes_number; ++p)
+		{
+			plane_x[p] = _mm_set1_ps(planes[p].x);
+			plane_y[p] = _mm_set1_ps(planes[p].y);
+			plane_z[p] = _mm_set1_ps(planes[p].z);
+			plane_w[p] = _mm_set1_ps(planes[p].w);
+			abs_x[p] = _mm_set1_ps(fabsf(planes[p].x));
+			abs_y[p] = _mm_set1_ps(fabsf(planes[p].y));
+			abs_z[p] = _mm_set1_ps(fabsf(planes[p].z));
+		}
+		const __m128 zero = _mm_setzero_ps();
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 cx = _mm_loadu_ps(&boxes.center_x[i]);
+			const __m128 cy = _mm_loadu_ps(&boxes.center_y[i]);
+			const __m128 cz = _mm_loadu_ps(&boxes.center_z[i]);
+			const __m128 ex = _mm_loadu_ps(&boxes.extent_x[i]);
+			const __m128 ey = _mm_loadu_ps(&boxes.extent_y[i]);
+			const __m128 ez = _mm_loadu_ps(&boxes.extent_z[i]);
+			__m128 outside = zero;
+			for (int p = 0; p < planes_number; ++p)
+			{
+				__m128 distance = _mm_add_ps(_mm_mul_ps(plane_x[p], cx), plane_w[p]);
+				distance = _mm_add_ps(distance, _mm_mul_ps(plane_y[p], cy));
+				distance = _mm_add_ps(distance, _mm_mul_ps(plane_z[p], cz));
+				__m128 reach = _mm_mul_ps(abs_x[p], ex);
+				reach = _mm_add_ps(reach, _mm_mul_ps(abs_y[p], ey));
+				reach = _mm_add_ps(reach, _mm_mul_ps(abs_z[p], ez));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, reach), zero));
+			}
+			const int mask = ~_mm_movemask_ps(outside) & 0xF;
+			for (int lane = 0; lane < 4; ++lane)
+			{
+				if (mask & (1 << lane))
+				{
+					visible[visible_number++] = static_cast<uint32_t>(i + lane);
+				}
+			}
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			bool inside = true;
+			for (const Vector_4d& plane : planes)
+			{
+				const float distance = plane.x * boxes.center_x[i] + plane.y * boxes.center_y[i] +
+									   plane.z * boxes.center_z[i] + plane.w;
+				const float reach = fabsf(plane.x) * boxes.extent_x[i] + fabsf(plane.y) * boxes.extent_y[i] +
+									fabsf(plane.z) * boxes.extent_z[i];
+				if (distance + reach < 0.0f)
+				{
+					inside = false;
+					break;
+				}
+			}
+			if (inside)
+			{
+				visible[visible_number++] = static_cast<uint32_t>(i);
+			}
+		}
+		return visible_number;
+	}
+
+	Vector_3d get_view_position(const Matrix_4x4& view)
+	{
+		const Matrix_4x4 camera = inverse(view);
+		return Vector_3d(camera.m[3][0], camera.m[3][1], camera.m[3][2]);
+	}
+}
@@ -0,0 +1,78 @@
+/******************************************************************************
+	 * File: math_3d_frustum.h
+	 * Description: Contains view frustum planes and visibility tests.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "math_3d.h"
+#include "math_3d_matrix.h"
+
+namespace Math_3d
+{
+	/**
+	* @struct Box_Batch
+	* Axis aligned boxes as centers and half sizes, one array per
+	* component, so four boxes load to one SSE register
+	*/
+	struct Box_Batch
+	{
+		std::vector<float> center_x, center_y, center_z;
+		std::vector<float> extent_x, extent_y, extent_z;
+
+		void clear();
+		void push_back(const Vector_3d& low, const Vector_3d& high);
+		/**
+		 * Box around box low, high moved by world (v * M)
+		 */
+		void push_back(const Vector_3d& low, const Vector_3d& high, const Matrix_4x4& world);
+		size_t size() const { return center_x.size(); }
+	};
+
+	/**
+	* @struct Frustum
+	* Planes (x, y, z, w) of view volume: point p is inside
+	* if x * p.x + y * p.y + z * p.z + w >= 0 for every plane.
+	* Normals are unit, so plane value is distance.
+	*/
+	struct Frustum
+	{
+		enum Plane
+		{
+			plane_left, plane_right, plane_bottom, plane_top, plane_near, plane_far,
+			planes_number
+		};
+
+		Vector_4d planes[planes_number];
+
+		/**
+		 * Planes of view * projection (D3D clip space, 0 <= z <= w)
+		 */
+		explicit Frustum(const Matrix_4x4& view_projection);
+
+		/**
+		 * False only if sphere is fully outside of some plane
+		 */
+		bool intersects_sphere(const Vector_3d& center, float radius) const;
+
+		/**
+		 * Write to visible (at least boxes.size() entries) indices of
+		 * boxes not fully outside of some plane, return their number.
+		 * Four boxes are tested at once where SSE is available.
+		 */
+		size_t cull_boxes(const Box_Batch& boxes, uint32_t* visible) const;
+	};
+
+	/**
+	 * Camera position in world, translation of inverse view
+	 */
+	Vector_3d get_view_position(const Matrix_4x4& view);
+}
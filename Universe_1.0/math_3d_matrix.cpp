@@ -0,0 +1,334 @@
+/******************************************************************************
+	 * File: math_3d_matrix.cpp
+	 * Description: Contains 4x4 matrix and transform builders for 3D.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include "math_3d_matrix.h"
+
+// SSE is baseline for x64 and for Win32 since VS 2012 (/arch:SSE2)
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MATH_3D_MATRIX_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Math_3d
+{
+#ifdef MATH_3D_MATRIX_SSE
+	namespace
+	{
+		// Component order is x, y, z, w, reverse of _MM_SHUFFLE
+		#define MATH_3D_SWIZZLE(vec, x, y, z, w) _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(w, z, y, x))
+		#define MATH_3D_SHUFFLE(vec_a, vec_b, x, y, z, w) _mm_shuffle_ps(vec_a, vec_b, _MM_SHUFFLE(w, z, y, x))
+
+		inline __m128 load_row(const Matrix_4x4& mat, int i)
+		{
+			return _mm_loadu_ps(mat.m[i]);
+		}
+
+		/**
+		 * Row of mat_a by whole mat_b
+		 */
+		inline __m128 row_mul(__m128 row, __m128 b0, __m128 b1, __m128 b2, __m128 b3)
+		{
+			__m128 result = _mm_mul_ps(MATH_3D_SWIZZLE(row, 0, 0, 0, 0), b0);
+			result = _mm_add_ps(result, _mm_mul_ps(MATH_3D_SWIZZLE(row, 1, 1, 1, 1), b1));
+			result = _mm_add_ps(result, _mm_mul_ps(MATH_3D_SWIZZLE(row, 2, 2, 2, 2), b2));
+			result = _mm_add_ps(result, _mm_mul_ps(MATH_3D_SWIZZLE(row, 3, 3, 3, 3), b3));
+			return result;
+		}
+
+		// 2x2 blocks are stored row-major in one register: (m00, m01, m10, m11)
+		/**
+		 * vec_a * vec_b
+		 */
+		inline __m128 mat_2x2_mul(__m128 vec_a, __m128 vec_b)
+		{
+			return _mm_add_ps(_mm_mul_ps(vec_a, MATH_3D_SWIZZLE(vec_b, 0, 3, 0, 3)),
+							  _mm_mul_ps(MATH_3D_SWIZZLE(vec_a, 1, 0, 3, 2), MATH_3D_SWIZZLE(vec_b, 2, 1, 2, 1)));
+		}
+		/**
+		 * adjugate(vec_a) * vec_b
+		 */
+		inline __m128 mat_2x2_adj_mul(__m128 vec_a, __m128 vec_b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(MATH_3D_SWIZZLE(vec_a, 3, 3, 0, 0), vec_b),
+							  _mm_mul_ps(MATH_3D_SWIZZLE(vec_a, 1, 1, 2, 2), MATH_3D_SWIZZLE(vec_b, 2, 3, 0, 1)));
+		}
+		/**
+		 * vec_a * adjugate(vec_b)
+		 */
+		inline __m128 mat_2x2_mul_adj(__m128 vec_a, __m128 vec_b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(vec_a, MATH_3D_SWIZZLE(vec_b, 3, 0, 3, 0)),
+							  _mm_mul_ps(MATH_3D_SWIZZLE(vec_a, 1, 0, 3, 2), MATH_3D_SWIZZLE(vec_b, 2, 1, 2, 1)));
+		}
+	}
+#endif
+
+	Matrix_4x4::Matrix_4x4()
+	: Matrix_4x4(1.0f, 0.0f, 0.0f, 0.0f,
+				 0.0f, 1.0f, 0.0f, 0.0f,
+				 0.0f, 0.0f, 1.0f, 0.0f,
+				 0.0f, 0.0f, 0.0f, 1.0f) {}
+
+	Matrix_4x4::Matrix_4x4(float m00, float m01, float m02, float m03,
+						   float m10, float m11, float m12, float m13,
+						   float m20, float m21, float m22, float m23,
+						   float m30, float m31, float m32, float m33)
+	{
+		m[0][0] = m00; m[0][1] = m01; m[0][2] = m02; m[0][3] = m03;
+		m[1][0] = m10; m[1][1] = m11; m[1][2] = m12; m[1][3] = m13;
+		m[2][0] = m20; m[2][1] = m21; m[2][2] = m22; m[2][3] = m23;
+		m[3][0] = m30; m[3][1] = m31; m[3][2] = m32; m[3][3] = m33;
+	}
+
+	Matrix_4x4& Matrix_4x4::operator*=(const Matrix_4x4& mat)
+	{
+		*this = *this * mat;
+		return *this;
+	}
+
+	Vector_4d Matrix_4x4::row(int i) const
+	{
+		return { m[i][0], m[i][1], m[i][2], m[i][3] };
+	}
+
+	const float* Matrix_4x4::data() const
+	{
+		return &m[0][0];
+	}
+
+	Matrix_4x4 operator*(const Matrix_4x4& mat_a, const Matrix_4x4& mat_b)
+	{
+		Matrix_4x4 result;
+#ifdef MATH_3D_MATRIX_SSE
+		__m128 b0 = load_row(mat_b, 0);
+		__m128 b1 = load_row(mat_b, 1);
+		__m128 b2 = load_row(mat_b, 2);
+		__m128 b3 = load_row(mat_b, 3);
+		for (int i = 0; i < 4; ++i)
+		{
+			_mm_storeu_ps(result.m[i], row_mul(load_row(mat_a, i), b0, b1, b2, b3));
+		}
+#else
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				result.m[i][j] = mat_a.m[i][0] * mat_b.m[0][j] + mat_a.m[i][1] * mat_b.m[1][j] +
+								 mat_a.m[i][2] * mat_b.m[2][j] + mat_a.m[i][3] * mat_b.m[3][j];
+			}
+		}
+#endif
+		return result;
+	}
+
+	Vector_4d operator*(const Vector_4d& vec, const Matrix_4x4& mat)
+	{
+		return { vec.x * mat.m[0][0] + vec.y * mat.m[1][0] + vec.z * mat.m[2][0] + vec.w * mat.m[3][0],
+				 vec.x * mat.m[0][1] + vec.y * mat.m[1][1] + vec.z * mat.m[2][1] + vec.w * mat.m[3][1],
+				 vec.x * mat.m[0][2] + vec.y * mat.m[1][2] + vec.z * mat.m[2][2] + vec.w * mat.m[3][2],
+				 vec.x * mat.m[0][3] + vec.y * mat.m[1][3] + vec.z * mat.m[2][3] + vec.w * mat.m[3][3] };
+	}
+
+	Vector_3d transform_point(const Vector_3d& point, const Matrix_4x4& mat)
+	{
+		return { point.x * mat.m[0][0] + point.y * mat.m[1][0] + point.z * mat.m[2][0] + mat.m[3][0],
+				 point.x * mat.m[0][1] + point.y * mat.m[1][1] + point.z * mat.m[2][1] + mat.m[3][1],
+				 point.x * mat.m[0][2] + point.y * mat.m[1][2] + point.z * mat.m[2][2] + mat.m[3][2] };
+	}
+
+	Vector_3d transform_vector(const Vector_3d& vec, const Matrix_4x4& mat)
+	{
+		return { vec.x * mat.m[0][0] + vec.y * mat.m[1][0] + vec.z * mat.m[2][0],
+				 vec.x * mat.m[0][1] + vec.y * mat.m[1][1] + vec.z * mat.m[2][1],
+				 vec.x * mat.m[0][2] + vec.y * mat.m[1][2] + vec.z * mat.m[2][2] };
+	}
+
+	Matrix_4x4 transpose(const Matrix_4x4& mat)
+	{
+		Matrix_4x4 result;
+#ifdef MATH_3D_MATRIX_SSE
+		__m128 r0 = load_row(mat, 0);
+		__m128 r1 = load_row(mat, 1);
+		__m128 r2 = load_row(mat, 2);
+		__m128 r3 = load_row(mat, 3);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(result.m[0], r0);
+		_mm_storeu_ps(result.m[1], r1);
+		_mm_storeu_ps(result.m[2], r2);
+		_mm_storeu_ps(result.m[3], r3);
+#else
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				result.m[i][j] = mat.m[j][i];
+			}
+		}
+#endif
+		return result;
+	}
+
+	float determinant(const Matrix_4x4& mat)
+	{
+		const float (&m)[4][4] = mat.m;
+		// 2x2 minors of two lower rows
+		float s0 = m[2][0] * m[3][1] - m[2][1] * m[3][0];
+		float s1 = m[2][0] * m[3][2] - m[2][2] * m[3][0];
+		float s2 = m[2][0] * m[3][3] - m[2][3] * m[3][0];
+		float s3 = m[2][1] * m[3][2] - m[2][2] * m[3][1];
+		float s4 = m[2][1] * m[3][3] - m[2][3] * m[3][1];
+		float s5 = m[2][2] * m[3][3] - m[2][3] * m[3][2];
+		// 2x2 minors of two upper rows
+		float c0 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+		float c1 = m[0][0] * m[1][2] - m[0][2] * m[1][0];
+		float c2 = m[0][0] * m[1][3] - m[0][3] * m[1][0];
+		float c3 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+		float c4 = m[0][1] * m[1][3] - m[0][3] * m[1][1];
+		float c5 = m[0][2] * m[1][3] - m[0][3] * m[1][2];
+
+		return c0 * s5 - c1 * s4 + c2 * s3 + c3 * s2 - c4 * s1 + c5 * s0;
+	}
+
+	Matrix_4x4 inverse(const Matrix_4x4& mat)
+	{
+		Matrix_4x4 result;
+#ifdef MATH_3D_MATRIX_SSE
+		// Block method:
+		// M = | A B |   M^-1 = 1/|M| * | X Y |
+		//     | C D |                  | Z W |
+		// where A..D are 2x2 and X..W are built from their adjugates
+		__m128 r0 = load_row(mat, 0);
+		__m128 r1 = load_row(mat, 1);
+		__m128 r2 = load_row(mat, 2);
+		__m128 r3 = load_row(mat, 3);
+
+		__m128 a = _mm_movelh_ps(r0, r1);
+		__m128 b = _mm_movehl_ps(r1, r0);
+		__m128 c = _mm_movelh_ps(r2, r3);
+		__m128 d = _mm_movehl_ps(r3, r2);
+
+		// (|A|, |B|, |C|, |D|)
+		__m128 det_sub = _mm_sub_ps(_mm_mul_ps(MATH_3D_SHUFFLE(r0, r2, 0, 2, 0, 2), MATH_3D_SHUFFLE(r1, r3, 1, 3, 1, 3)),
+									_mm_mul_ps(MATH_3D_SHUFFLE(r0, r2, 1, 3, 1, 3), MATH_3D_SHUFFLE(r1, r3, 0, 2, 0, 2)));
+		__m128 det_a = MATH_3D_SWIZZLE(det_sub, 0, 0, 0, 0);
+		__m128 det_b = MATH_3D_SWIZZLE(det_sub, 1, 1, 1, 1);
+		__m128 det_c = MATH_3D_SWIZZLE(det_sub, 2, 2, 2, 2);
+		__m128 det_d = MATH_3D_SWIZZLE(det_sub, 3, 3, 3, 3);
+
+		__m128 d_c = mat_2x2_adj_mul(d, c);
+		__m128 a_b = mat_2x2_adj_mul(a, b);
+		// Adjugates of X, Y, Z, W
+		__m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat_2x2_mul(b, d_c));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat_2x2_mul(c, a_b));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), mat_2x2_mul_adj(d, a_b));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat_2x2_mul_adj(a, d_c));
+
+		// |M| = |A| * |D| + |B| * |C| - tr((A#B)(D#C))
+		__m128 trace = _mm_mul_ps(a_b, MATH_3D_SWIZZLE(d_c, 0, 2, 1, 3));
+		trace = _mm_add_ps(trace, MATH_3D_SWIZZLE(trace, 1, 0, 3, 2));
+		trace = _mm_add_ps(trace, MATH_3D_SWIZZLE(trace, 2, 3, 0, 1));
+		__m128 det_m = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), trace);
+
+		// (1/|M|, -1/|M|, -1/|M|, 1/|M|) also applies adjugate signs
+		__m128 inv_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det_m);
+		x = _mm_mul_ps(x, inv_det);
+		y = _mm_mul_ps(y, inv_det);
+		z = _mm_mul_ps(z, inv_det);
+		w = _mm_mul_ps(w, inv_det);
+
+		// Adjugate swizzle and store
+		_mm_storeu_ps(result.m[0], MATH_3D_SHUFFLE(x, y, 3, 1, 3, 1));
+		_mm_storeu_ps(result.m[1], MATH_3D_SHUFFLE(x, y, 2, 0, 2, 0));
+		_mm_storeu_ps(result.m[2], MATH_3D_SHUFFLE(z, w, 3, 1, 3, 1));
+		_mm_storeu_ps(result.m[3], MATH_3D_SHUFFLE(z, w, 2, 0, 2, 0));
+#else
+		const float (&m)[4][4] = mat.m;
+		float s0 = m[2][0] * m[3][1] - m[2][1] * m[3][0];
+		float s1 = m[2][0] * m[3][2] - m[2][2] * m[3][0];
+		float s2 = m[2][0] * m[3][3] - m[2][3] * m[3][0];
+		float s3 = m[2][1] * m[3][2] - m[2][2] * m[3][1];
+		float s4 = m[2][1] * m[3][3] - m[2][3] * m[3][1];
+		float s5 = m[2][2] * m[3][3] - m[2][3] * m[3][2];
+		float c0 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+		float c1 = m[0][0] * m[1][2] - m[0][2] * m[1][0];
+		float c2 = m[0][0] * m[1][3] - m[0][3] * m[1][0];
+		float c3 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+		float c4 = m[0][1] * m[1][3] - m[0][3] * m[1][1];
+		float c5 = m[0][2] * m[1][3] - m[0][3] * m[1][2];
+
+		float inv_det = 1.0f / (c0 * s5 - c1 * s4 + c2 * s3 + c3 * s2 - c4 * s1 + c5 * s0);
+
+		result.m[0][0] = ( m[1][1] * s5 - m[1][2] * s4 + m[1][3] * s3) * inv_det;
+		result.m[0][1] = (-m[0][1] * s5 + m[0][2] * s4 - m[0][3] * s3) * inv_det;
+		result.m[0][2] = ( m[3][1] * c5 - m[3][2] * c4 + m[3][3] * c3) * inv_det;
+		result.m[0][3] = (-m[2][1] * c5 + m[2][2] * c4 - m[2][3] * c3) * inv_det;
+
+		result.m[1][0] = (-m[1][0] * s5 + m[1][2] * s2 - m[1][3] * s1) * inv_det;
+		result.m[1][1] = ( m[0][0] * s5 - m[0][2] * s2 + m[0][3] * s1) * inv_det;
+		result.m[1][2] = (-m[3][0] * c5 + m[3][2] * c2 - m[3][3] * c1) * inv_det;
+		result.m[1][3] = ( m[2][0] * c5 - m[2][2] * c2 + m[2][3] * c1) * inv_det;
+
+		result.m[2][0] = ( m[1][0] * s4 - m[1][1] * s2 + m[1][3] * s0) * inv_det;
+		result.m[2][1] = (-m[0][0] * s4 + m[0][1] * s2 - m[0][3] * s0) * inv_det;
+		result.m[2][2] = ( m[3][0] * c4 - m[3][1] * c2 + m[3][3] * c0) * inv_det;
+		result.m[2][3] = (-m[2][0] * c4 + m[2][1] * c2 - m[2][3] * c0) * inv_det;
+
+		result.m[3][0] = (-m[1][0] * s3 + m[1][1] * s1 - m[1][2] * s0) * inv_det;
+		result.m[3][1] = ( m[0][0] * s3 - m[0][1] * s1 + m[0][2] * s0) * inv_det;
+		result.m[3][2] = (-m[3][0] * c3 + m[3][1] * c1 - m[3][2] * c0) * inv_det;
+		result.m[3][3] = ( m[2][0] * c3 - m[2][1] * c1 + m[2][2] * c0) * inv_det;
+#endif
+		return result;
+	}
+
+	Matrix_4x4 translation(Vector_3d offset)
+	{
+		return { 1.0f,     0.0f,     0.0f,     0.0f,
+				 0.0f,     1.0f,     0.0f,     0.0f,
+				 0.0f,     0.0f,     1.0f,     0.0f,
+				 offset.x, offset.y, offset.z, 1.0f };
+	}
+
+	Matrix_4x4 scaling(Vector_3d scale)
+	{
+		return { scale.x, 0.0f,    0.0f,    0.0f,
+				 0.0f,    scale.y, 0.0f,    0.0f,
+				 0.0f,    0.0f,    scale.z, 0.0f,
+				 0.0f,    0.0f,    0.0f,    1.0f };
+	}
+
+	Matrix_4x4 look_at_lh(Vector_3d eye, Vector_3d at, Vector_3d up)
+	{
+		// View basis: z looks from eye to target, x is right, y is up
+		Vector_3d axis_z = (at - eye).normalize();
+		Vector_3d axis_x = (up ^ axis_z).normalize();
+		Vector_3d axis_y = axis_z ^ axis_x;
+
+		return { axis_x.x,        axis_y.x,        axis_z.x,        0.0f,
+				 axis_x.y,        axis_y.y,        axis_z.y,        0.0f,
+				 axis_x.z,        axis_y.z,        axis_z.z,        0.0f,
+				 -(axis_x & eye), -(axis_y & eye), -(axis_z & eye), 1.0f };
+	}
+
+	Matrix_4x4 perspective_fov_lh(float fov_y, float aspect, float near_z, float far_z)
+	{
+		float height = cos(0.5f * fov_y) / sin(0.5f * fov_y);
+		float width = height / aspect;
+		float range = far_z / (far_z - near_z);
+
+		return { width, 0.0f,   0.0f,             0.0f,
+				 0.0f,  height, 0.0f,             0.0f,
+				 0.0f,  0.0f,   range,            1.0f,
+				 0.0f,  0.0f,   -range * near_z,  0.0f };
+	}
+}
+
+#undef MATH_3D_SWIZZLE
+#undef MATH_3D_SHUFFLE
@@ -0,0 +1,81 @@
+/******************************************************************************
+	 * File: math_3d_matrix.h
+	 * Description: Contains 4x4 matrix and transform builders for 3D.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+
+#include "math_3d.h"
+
+namespace Math_3d
+{
+	/**
+	* @struct Matrix_4x4
+	* Row-major 4x4 matrix. Vectors are rows multiplied from the left
+	* (v * M), same convention and memory layout as XMMATRIX, so it can
+	* be copied to XMMATRIX / constant buffers as is.
+	*/
+	struct alignas(16) Matrix_4x4
+	{
+		float m[4][4];
+
+		/**
+		 * Identity matrix
+		 */
+		Matrix_4x4();
+		Matrix_4x4(float m00, float m01, float m02, float m03,
+				   float m10, float m11, float m12, float m13,
+				   float m20, float m21, float m22, float m23,
+				   float m30, float m31, float m32, float m33);
+		Matrix_4x4(const Matrix_4x4& mat) = default;
+
+		Matrix_4x4& operator=(const Matrix_4x4& mat) = default;
+		Matrix_4x4& operator*=(const Matrix_4x4& mat);
+
+		Vector_4d row(int i) const;
+		const float* data() const;
+	};
+
+	/**
+	 * mat_a * mat_b, i.e. apply mat_a first, then mat_b
+	 */
+	Matrix_4x4 operator*(const Matrix_4x4& mat_a, const Matrix_4x4& mat_b);
+	/**
+	 * Row vector by matrix: vec * mat
+	 */
+	Vector_4d operator*(const Vector_4d& vec, const Matrix_4x4& mat);
+
+	/**
+	 * Point transform, w = 1, result w is dropped
+	 */
+	Vector_3d transform_point(const Vector_3d& point, const Matrix_4x4& mat);
+	/**
+	 * Direction transform, w = 0, translation is ignored
+	 */
+	Vector_3d transform_vector(const Vector_3d& vec, const Matrix_4x4& mat);
+
+	Matrix_4x4 transpose(const Matrix_4x4& mat);
+	float determinant(const Matrix_4x4& mat);
+	/**
+	 * General inverse. Result of singular matrix is not finite,
+	 * check determinant() first if it is possible.
+	 */
+	Matrix_4x4 inverse(const Matrix_4x4& mat);
+
+	Matrix_4x4 translation(Vector_3d offset);
+	Matrix_4x4 scaling(Vector_3d scale);
+	/**
+	 * Left-handed view matrix, same as XMMatrixLookAtLH
+	 */
+	Matrix_4x4 look_at_lh(Vector_3d eye, Vector_3d at, Vector_3d up);
+	/**
+	 * Left-handed perspective projection, same as XMMatrixPerspectiveFovLH
+	 * fov_y is in radians
+	 */
+	Matrix_4x4 perspective_fov_lh(float fov_y, float aspect, float near_z, float far_z);
+}
@@ -0,0 +1,144 @@
+/******************************************************************************
+	 * File: math_3d_precision.cpp
+	 * Description: Contains precision policies benchmark.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <chrono>
+#include <random>
+#include <utility>
+
+#include "math_3d_precision.h"
+
+namespace Math_3d
+{
+	namespace
+	{
+		using Vector_Pair = std::pair<Vector_3d, Vector_3d>;
+
+		// Keeps benchmark loops from being optimized away
+		volatile float sink = 0.0f;
+
+		template<class Arg, class Call>
+		double time_per_call(const std::vector<Arg>& args, Call call)
+		{
+			auto start = std::chrono::steady_clock::now();
+			float sum = 0.0f;
+			for (const Arg& arg : args)
+			{
+				sum += call(arg);
+			}
+			auto finish = std::chrono::steady_clock::now();
+			sink = sum;
+			return std::chrono::duration<double, std::nano>(finish - start).count() / static_cast<double>(args.size());
+		}
+
+		template<class Arg, class Exact_Call, class Fast_Call, class Reference>
+		Precision_Result measure(const char* name, const std::vector<Arg>& args,
+								 Exact_Call exact_call, Fast_Call fast_call, Reference reference)
+		{
+			Precision_Result result;
+			result.name = name;
+			for (const Arg& arg : args)
+			{
+				double expected = reference(arg);
+				double abs_error = fabs(static_cast<double>(fast_call(arg)) - expected);
+				if (abs_error > result.max_abs_error)
+				{
+					result.max_abs_error = abs_error;
+				}
+				if (expected != 0.0 && abs_error / fabs(expected) > result.max_rel_error)
+				{
+					result.max_rel_error = abs_error / fabs(expected);
+				}
+			}
+			result.exact_ns = time_per_call(args, exact_call);
+			result.fast_ns = time_per_call(args, fast_call);
+			return result;
+		}
+
+		double length_double(const Vector_3d& vec)
+		{
+			double x = vec.x, y = vec.y, z = vec.z;
+			return ::sqrt(x * x + y * y + z * z);
+		}
+	}
+
+	std::vector<Precision_Result> run_precision_benchmark(size_t samples)
+	{
+		using Exact = Precision::Exact;
+		using Fast = Precision::Fast;
+
+		std::mt19937 generator(20201016);
+		std::uniform_real_distribution<float> positive(1e-6f, 1e6f);
+		std::uniform_real_distribution<float> angles(-100.0f * pi, 100.0f * pi);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> coords(-100.0f, 100.0f);
+
+		std::vector<float> positive_args(samples);
+		std::vector<float> angle_args(samples);
+		std::vector<float> unit_args(samples);
+		std::vector<Vector_3d> vector_args(samples);
+		std::vector<Vector_Pair> pair_args(samples);
+		for (size_t i = 0; i < samples; ++i)
+		{
+			positive_args[i] = positive(generator);
+			angle_args[i] = angles(generator);
+			unit_args[i] = unit(generator);
+			vector_args[i] = Vector_3d(coords(generator), coords(generator), coords(generator));
+			pair_args[i].first = Vector_3d(coords(generator), coords(generator), coords(generator));
+			pair_args[i].second = Vector_3d(coords(generator), coords(generator), coords(generator));
+		}
+
+		std::vector<Precision_Result> results;
+
+		results.push_back(measure("sqrt", positive_args,
+			[](float x) { return Exact::sqrt(x); },
+			[](float x) { return Fast::sqrt(x); },
+			[](float x) { return ::sqrt(static_cast<double>(x)); }));
+		results.push_back(measure("rsqrt", positive_args,
+			[](float x) { return Exact::rsqrt(x); },
+			[](float x) { return Fast::rsqrt(x); },
+			[](float x) { return 1.0 / ::sqrt(static_cast<double>(x)); }));
+		results.push_back(measure("sin", angle_args,
+			[](float x) { return Exact::sin(x); },
+			[](float x) { return Fast::sin(x); },
+			[](float x) { return ::sin(static_cast<double>(x)); }));
+		results.push_back(measure("cos", angle_args,
+			[](float x) { return Exact::cos(x); },
+			[](float x) { return Fast::cos(x); },
+			[](float x) { return ::cos(static_cast<double>(x)); }));
+		results.push_back(measure("acos", unit_args,
+			[](float x) { return Exact::acos(x); },
+			[](float x) { return Fast::acos(x); },
+			[](float x) { return ::acos(static_cast<double>(x)); }));
+		results.push_back(measure("length", vector_args,
+			[](const Vector_3d& vec) { return length<Exact>(vec); },
+			[](const Vector_3d& vec) { return length<Fast>(vec); },
+			[](const Vector_3d& vec) { return length_double(vec); }));
+		results.push_back(measure("normalized", vector_args,
+			[](const Vector_3d& vec) { return normalized<Exact>(vec).x; },
+			[](const Vector_3d& vec) { return normalized<Fast>(vec).x; },
+			[](const Vector_3d& vec) { return vec.x / length_double(vec); }));
+		results.push_back(measure("distance", pair_args,
+			[](const Vector_Pair& pair) { return distance<Exact>(pair.first, pair.second); },
+			[](const Vector_Pair& pair) { return distance<Fast>(pair.first, pair.second); },
+			[](const Vector_Pair& pair) { return length_double(pair.second - pair.first); }));
+		results.push_back(measure("angle", pair_args,
+			[](const Vector_Pair& pair) { return angle<Exact>(pair.first, pair.second); },
+			[](const Vector_Pair& pair) { return angle<Fast>(pair.first, pair.second); },
+			[](const Vector_Pair& pair)
+			{
+				const Vector_3d& a = pair.first;
+				const Vector_3d& b = pair.second;
+				double dot = static_cast<double>(a.x) * b.x + static_cast<double>(a.y) * b.y + static_cast<double>(a.z) * b.z;
+				return ::acos(dot / (length_double(a) * length_double(b)));
+			}));
+
+		return results;
+	}
+}
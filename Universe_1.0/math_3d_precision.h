@@ -0,0 +1,285 @@
+/******************************************************************************
+	 * File: math_3d_precision.h
+	 * Description: Contains precision policies for 3D math.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "math_3d.h"
+
+// SSE is baseline for x64 and for Win32 since VS 2012 (/arch:SSE2)
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MATH_3D_PRECISION_SSE
+#include <xmmintrin.h>
+#else
+#include <string.h>
+#endif
+
+namespace Math_3d
+{
+	/**
+	 * Precision policies.
+	 * Policy is a compile-time parameter of length, normalized, distance
+	 * and angle below, so each subsystem picks it once, e.g.
+	 *   using Precision = Math_3d::Precision::Fast;
+	 *   float len = Math_3d::length<Precision>(vec);
+	 * Use run_precision_benchmark() to compare policies.
+	 */
+	namespace Precision
+	{
+		/**
+		* @struct Exact
+		* Same results as Vector_3d::length, normalize, distance and angle:
+		* widen to double and call libm.
+		*/
+		struct Exact
+		{
+			static float sqrt(float x)
+			{
+				return static_cast<float>(::sqrt(static_cast<double>(x)));
+			}
+			static float rsqrt(float x)
+			{
+				return static_cast<float>(1.0 / ::sqrt(static_cast<double>(x)));
+			}
+			static float sin(float x)
+			{
+				return static_cast<float>(::sin(static_cast<double>(x)));
+			}
+			static float cos(float x)
+			{
+				return static_cast<float>(::cos(static_cast<double>(x)));
+			}
+			static float acos(float x)
+			{
+				return static_cast<float>(::acos(static_cast<double>(x)));
+			}
+
+			static float length(Vector_3d vec)
+			{
+				return vec.length();
+			}
+			static Vector_3d normalized(Vector_3d vec)
+			{
+				return vec.normalize();
+			}
+			static float distance(const Vector_3d& vec_a, const Vector_3d& vec_b)
+			{
+				return Math_3d::distance(vec_a, vec_b);
+			}
+			static float angle(const Vector_3d& vec_a, const Vector_3d& vec_b)
+			{
+				return Math_3d::angle(vec_a, vec_b);
+			}
+		};
+
+		/**
+		* @struct Fast
+		* Float only, no libm calls below |x| = 1e9. Measured max errors
+		* (see run_precision_benchmark):
+		*  - rsqrt, sqrt: relative 2.8e-7 (SSE), 4.8e-6 (portable)
+		*  - sin, cos: absolute 2.9e-7 for |x| <= 1e4 (float range
+		*    reduction), 4e-7 for |x| <= 1e9 (double reduction),
+		*    libm above that
+		*  - acos: absolute 6.8e-5 rad (0.004 degree)
+		*  - length, distance: relative 3.5e-7
+		*  - normalized: absolute 2.6e-7 per component
+		*  - angle: absolute 1.2e-4 rad
+		* Zero length vectors give zero (length, distance)
+		* or the zero vector (normalized) instead of NaN.
+		*/
+		struct Fast
+		{
+			/**
+			 * 1 / sqrt(x) for x > 0: hardware estimate (12 bits)
+			 * or bit trick, refined by Newton-Raphson
+			 */
+			static float rsqrt(float x)
+			{
+#ifdef MATH_3D_PRECISION_SSE
+				float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+				return y * (1.5f - 0.5f * x * y * y);
+#else
+				unsigned int bits;
+				memcpy(&bits, &x, sizeof(bits));
+				bits = 0x5f375a86u - (bits >> 1);
+				float y;
+				memcpy(&y, &bits, sizeof(y));
+				y = y * (1.5f - 0.5f * x * y * y);
+				return y * (1.5f - 0.5f * x * y * y);
+#endif
+			}
+			static float sqrt(float x)
+			{
+				return x > 0.0f ? x * rsqrt(x) : 0.0f;
+			}
+			static float sin(float x)
+			{
+				// Huge arguments (and inf, NaN) go to libm
+				if (!(x <= double_reduce_limit && x >= -double_reduce_limit))
+				{
+					return static_cast<float>(::sin(static_cast<double>(x)));
+				}
+				// Reduce to [-pi, pi], then fold to [-pi/2, pi/2]
+				float r = reduce(x);
+				if (r > half_pi)
+				{
+					r = pi - r;
+				}
+				else if (r < -half_pi)
+				{
+					r = -pi - r;
+				}
+				return sin_kernel(r);
+			}
+			static float cos(float x)
+			{
+				if (!(x <= double_reduce_limit && x >= -double_reduce_limit))
+				{
+					return static_cast<float>(::cos(static_cast<double>(x)));
+				}
+				// cos(r) = sin(pi/2 - |r|), argument stays in [-pi/2, pi/2]
+				float r = reduce(x);
+				return sin_kernel(half_pi - (r < 0.0f ? -r : r));
+			}
+			/**
+			 * Abramowitz and Stegun 4.4.45
+			 */
+			static float acos(float x)
+			{
+				float a = x < 0.0f ? -x : x;
+				if (a > 1.0f)
+				{
+					a = 1.0f;
+				}
+				float result = sqrt(1.0f - a) * (1.5707288f + a * (-0.2121144f + a * (0.0742610f + a * -0.0187293f)));
+				return x < 0.0f ? pi - result : result;
+			}
+
+			static float length(const Vector_3d& vec)
+			{
+				return sqrt(vec & vec);
+			}
+			static Vector_3d normalized(const Vector_3d& vec)
+			{
+				float len_sq = vec & vec;
+				if (len_sq > 0.0f)
+				{
+					return vec * rsqrt(len_sq);
+				}
+				return vec;
+			}
+			static float distance(const Vector_3d& vec_a, const Vector_3d& vec_b)
+			{
+				return length(vec_b - vec_a);
+			}
+			static float angle(const Vector_3d& vec_a, const Vector_3d& vec_b)
+			{
+				float arg = (vec_a & vec_b) * rsqrt((vec_a & vec_a) * (vec_b & vec_b));
+				return acos(arg);
+			}
+
+		private:
+			static constexpr float half_pi = 1.57079632679489661923f;
+			static constexpr float inv_two_pi = 0.15915494309189533577f;
+			// 2 * pi split in two parts, first one has short mantissa,
+			// so k * two_pi_hi is exact while k < 2^16
+			static constexpr float two_pi_hi = 6.28125f;
+			static constexpr float two_pi_lo = 0.0019353071795864769f;
+			// Float split keeps 3e-7 up to here
+			static constexpr float float_reduce_limit = 1e4f;
+			// Double product k * 2 pi keeps 1e-7 up to here
+			static constexpr float double_reduce_limit = 1e9f;
+			static constexpr double two_pi_double = 6.283185307179586476925;
+			static constexpr double inv_two_pi_double = 0.159154943091895335769;
+
+			/**
+			 * x - 2 pi k in [-pi, pi], for |x| <= double_reduce_limit
+			 */
+			static float reduce(float x)
+			{
+				const float a = x < 0.0f ? -x : x;
+				if (a <= float_reduce_limit)
+				{
+					float k = static_cast<float>(static_cast<int>(x * inv_two_pi + (x < 0.0f ? -0.5f : 0.5f)));
+					return (x - k * two_pi_hi) - k * two_pi_lo;
+				}
+				const double value = static_cast<double>(x);
+				const double k = static_cast<double>(static_cast<int>(value * inv_two_pi_double + (x < 0.0f ? -0.5 : 0.5)));
+				return static_cast<float>(value - k * two_pi_double);
+			}
+			/**
+			 * Odd minimax polynomial of degree 9 for sin on [-pi/2, pi/2],
+			 * approximation error 1.2e-8 before float rounding
+			 */
+			static float sin_kernel(float r)
+			{
+				float r2 = r * r;
+				return r * (0.99999999916f + r2 * (-0.16666662484f + r2 * (0.0083331307782f +
+						r2 * (-0.00019813423871f + r2 * 0.0000026125380358f))));
+			}
+		};
+	}
+
+	template<class Policy = Precision::Exact>
+	float length(const Vector_3d& vec)
+	{
+		return Policy::length(vec);
+	}
+
+	template<class Policy = Precision::Exact>
+	Vector_3d normalized(const Vector_3d& vec)
+	{
+		return Policy::normalized(vec);
+	}
+
+	/**
+	 * distance<Precision::Fast>(vec_a, vec_b),
+	 * plain distance(vec_a, vec_b) is the exact one
+	 */
+	template<class Policy>
+	float distance(const Vector_3d& vec_a, const Vector_3d& vec_b)
+	{
+		return Policy::distance(vec_a, vec_b);
+	}
+
+	/**
+	 * Angle in radians, angle<Precision::Fast>(vec_a, vec_b),
+	 * plain angle(vec_a, vec_b) is the exact one
+	 */
+	template<class Policy>
+	float angle(const Vector_3d& vec_a, const Vector_3d& vec_b)
+	{
+		return Policy::angle(vec_a, vec_b);
+	}
+
+	/**
+	* @struct Precision_Result
+	* Accuracy and speed of single function,
+	* Exact and Fast policies against double libm reference.
+	*/
+	struct Precision_Result
+	{
+		std::string name;
+		double max_abs_error = 0.0;
+		double max_rel_error = 0.0;
+		double exact_ns = 0.0;
+		double fast_ns = 0.0;
+	};
+
+	/**
+	 * Measure Fast policy errors and time per call of both policies
+	 * on `samples` pseudo-random arguments (fixed seed)
+	 */
+	std::vector<Precision_Result> run_precision_benchmark(size_t samples = 1 << 20);
+}
+
+#undef MATH_3D_PRECISION_SSE
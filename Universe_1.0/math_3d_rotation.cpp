@@ -0,0 +1,101 @@
+/******************************************************************************
+	 * File: math_3d_rotation.cpp
+	 * Description: Contains precomputed rotations for 3D.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include "math_3d_rotation.h"
+#include "math_3d_batch.h"
+
+namespace Math_3d
+{
+	Quaternion::Quaternion(Vector_3d axis, float angle)
+	{
+		float half_angle = degree_to_radian(angle) * 0.5f;
+		float sin_half = sin(half_angle);
+		x = axis.x * sin_half;
+		y = axis.y * sin_half;
+		z = axis.z * sin_half;
+		w = cos(half_angle);
+	}
+
+	Quaternion& Quaternion::normalize()
+	{
+		float len = sqrt(x * x + y * y + z * z + w * w);
+		x /= len;
+		y /= len;
+		z /= len;
+		w /= len;
+		return *this;
+	}
+
+	Quaternion Quaternion::conjugate() const
+	{
+		return { -x, -y, -z, w };
+	}
+
+	Quaternion operator*(const Quaternion& quat_a, const Quaternion& quat_b)
+	{
+		return { quat_a.w * quat_b.x + quat_a.x * quat_b.w + quat_a.y * quat_b.z - quat_a.z * quat_b.y,
+				 quat_a.w * quat_b.y - quat_a.x * quat_b.z + quat_a.y * quat_b.w + quat_a.z * quat_b.x,
+				 quat_a.w * quat_b.z + quat_a.x * quat_b.y - quat_a.y * quat_b.x + quat_a.z * quat_b.w,
+				 quat_a.w * quat_b.w - quat_a.x * quat_b.x - quat_a.y * quat_b.y - quat_a.z * quat_b.z };
+	}
+
+	Rotation::Rotation(Vector_3d axis, float angle)
+	{
+		angle = degree_to_radian(angle);
+		const float c = cos(angle);
+		const float s = sin(angle);
+		const float t = 1.0f - c;
+
+		// Rodrigues matrix R (column vectors, R * v) stored transposed
+		matrix.m[0][0] = c + t * axis.x * axis.x;
+		matrix.m[1][0] = t * axis.x * axis.y - s * axis.z;
+		matrix.m[2][0] = t * axis.x * axis.z + s * axis.y;
+
+		matrix.m[0][1] = t * axis.x * axis.y + s * axis.z;
+		matrix.m[1][1] = c + t * axis.y * axis.y;
+		matrix.m[2][1] = t * axis.y * axis.z - s * axis.x;
+
+		matrix.m[0][2] = t * axis.x * axis.z - s * axis.y;
+		matrix.m[1][2] = t * axis.y * axis.z + s * axis.x;
+		matrix.m[2][2] = c + t * axis.z * axis.z;
+	}
+
+	Rotation::Rotation(const Quaternion& quaternion)
+	{
+		const float x = quaternion.x, y = quaternion.y, z = quaternion.z, w = quaternion.w;
+
+		matrix.m[0][0] = 1.0f - 2.0f * (y * y + z * z);
+		matrix.m[1][0] = 2.0f * (x * y - z * w);
+		matrix.m[2][0] = 2.0f * (x * z + y * w);
+
+		matrix.m[0][1] = 2.0f * (x * y + z * w);
+		matrix.m[1][1] = 1.0f - 2.0f * (x * x + z * z);
+		matrix.m[2][1] = 2.0f * (y * z - x * w);
+
+		matrix.m[0][2] = 2.0f * (x * z - y * w);
+		matrix.m[1][2] = 2.0f * (y * z + x * w);
+		matrix.m[2][2] = 1.0f - 2.0f * (x * x + y * y);
+	}
+
+	Vector_3d Rotation::apply(const Vector_3d& vec) const
+	{
+		return transform_vector(vec, matrix);
+	}
+
+	void Rotation::apply(const Vector_3d* vec, Vector_3d* result, size_t count) const
+	{
+		Batch::transform_vectors(matrix, vec, result, count);
+	}
+
+	const Matrix_4x4& Rotation::get_matrix() const
+	{
+		return matrix;
+	}
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+	 * File: math_3d_rotation.h
+	 * Description: Contains precomputed rotations for 3D.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+
+#include "math_3d.h"
+#include "math_3d_matrix.h"
+
+namespace Math_3d
+{
+	/**
+	* @struct Quaternion
+	* Unit quaternion which represents rotation.
+	* Cheap to compose and interpolate, convert to Rotation
+	* to rotate many vectors.
+	*/
+	struct Quaternion
+	{
+		float x = 0.0f;
+		float y = 0.0f;
+		float z = 0.0f;
+		float w = 1.0f;
+
+		Quaternion() {};
+		Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {};
+		/**
+		 * Rotation around unit axis, angle in degrees
+		 */
+		Quaternion(Vector_3d axis, float angle);
+
+		Quaternion& normalize();
+		Quaternion conjugate() const;
+	};
+
+	/**
+	 * Composition: rotate by quat_b, then by quat_a
+	 */
+	Quaternion operator*(const Quaternion& quat_a, const Quaternion& quat_b);
+
+	/**
+	* @class Rotation
+	* Rotation matrix built once from axis and angle (or quaternion),
+	* then applied to any number of vectors without trigonometry
+	* and heap allocations.
+	*/
+	class Rotation
+	{
+		/**
+		 * Rotation in row-vector form (v * M), no translation
+		 */
+		Matrix_4x4 matrix;
+
+	public:
+		/**
+		 * Identity rotation
+		 */
+		Rotation() {};
+		/**
+		 * Rotation around unit axis, angle in degrees,
+		 * same as rotate_vector(vector, axis, angle)
+		 */
+		Rotation(Vector_3d axis, float angle);
+		explicit Rotation(const Quaternion& quaternion);
+
+		Vector_3d apply(const Vector_3d& vec) const;
+		/**
+		 * result[i] = apply(vec[i]), SIMD via Math_3d::Batch.
+		 * result may be equal to vec.
+		 */
+		void apply(const Vector_3d* vec, Vector_3d* result, size_t count) const;
+
+		const Matrix_4x4& get_matrix() const;
+	};
+}
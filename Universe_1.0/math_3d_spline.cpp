@@ -0,0 +1,182 @@
+/******************************************************************************
+	 * File: math_3d_spline.cpp
+	 * Description: Contains piecewise cubic curves for 3D.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include "math_3d_spline.h"
+
+namespace Math_3d
+{
+	namespace
+	{
+		// Component-wise, Vector_3d operators are not inlined across files
+		inline float horner(float a, float b, float c, float d, float s)
+		{
+			return a + s * (b + s * (c + s * d));
+		}
+
+		inline float horner_derivative(float b, float c, float d, float s)
+		{
+			return b + s * (2.0f * c + 3.0f * s * d);
+		}
+	}
+
+	Spline::Spline(const std::vector<Vector_3d>& control_points, Type type)
+	{
+		const size_t n = control_points.size();
+		if (n == 0)
+		{
+			return;
+		}
+		if (n == 1)
+		{
+			Segment segment;
+			segment.a = control_points[0];
+			segments.push_back(segment);
+			return;
+		}
+
+		if (type == Type::cubic_bezier)
+		{
+			segments.reserve((n - 1) / 3);
+			for (size_t i = 0; i + 3 < n; i += 3)
+			{
+				const Vector_3d& p0 = control_points[i];
+				const Vector_3d& p1 = control_points[i + 1];
+				const Vector_3d& p2 = control_points[i + 2];
+				const Vector_3d& p3 = control_points[i + 3];
+
+				Segment segment;
+				segment.a = p0;
+				segment.b = 3.0f * (p1 - p0);
+				segment.c = 3.0f * (p0 - 2.0f * p1 + p2);
+				segment.d = p3 - p0 + 3.0f * (p1 - p2);
+				segments.push_back(segment);
+			}
+			return;
+		}
+
+		// Catmull-Rom and B-spline segment i is driven by points i - 1 .. i + 2,
+		// missing end points are mirrored, so the curve starts at first
+		// control point and ends at last one
+		auto point = [&control_points, n](ptrdiff_t i) -> Vector_3d
+		{
+			if (i < 0)
+			{
+				return 2.0f * control_points[0] - control_points[1];
+			}
+			if (i >= static_cast<ptrdiff_t>(n))
+			{
+				return 2.0f * control_points[n - 1] - control_points[n - 2];
+			}
+			return control_points[i];
+		};
+
+		segments.reserve(n - 1);
+		for (ptrdiff_t i = 0; i + 1 < static_cast<ptrdiff_t>(n); ++i)
+		{
+			const Vector_3d p0 = point(i - 1);
+			const Vector_3d p1 = point(i);
+			const Vector_3d p2 = point(i + 1);
+			const Vector_3d p3 = point(i + 2);
+
+			Segment segment;
+			if (type == Type::catmull_rom)
+			{
+				segment.a = p1;
+				segment.b = 0.5f * (p2 - p0);
+				segment.c = 0.5f * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3);
+				segment.d = 0.5f * (p3 - p0 + 3.0f * (p1 - p2));
+			}
+			else
+			{
+				segment.a = (p0 + 4.0f * p1 + p2) / 6.0f;
+				segment.b = 0.5f * (p2 - p0);
+				segment.c = 0.5f * (p0 - 2.0f * p1 + p2);
+				segment.d = (p3 - p0 + 3.0f * (p1 - p2)) / 6.0f;
+			}
+			segments.push_back(segment);
+		}
+	}
+
+	size_t Spline::locate(float t, float& s) const
+	{
+		float x = t * static_cast<float>(segments.size());
+		if (x <= 0.0f)
+		{
+			s = x;
+			return 0;
+		}
+		size_t index = static_cast<size_t>(x);
+		if (index >= segments.size())
+		{
+			index = segments.size() - 1;
+		}
+		s = x - static_cast<float>(index);
+		return index;
+	}
+
+	size_t Spline::get_segments_number() const
+	{
+		return segments.size();
+	}
+
+	Vector_3d Spline::get_point(float t) const
+	{
+		if (segments.empty())
+		{
+			return Vector_3d();
+		}
+		float s;
+		const Segment& seg = segments[locate(t, s)];
+		return { horner(seg.a.x, seg.b.x, seg.c.x, seg.d.x, s),
+				 horner(seg.a.y, seg.b.y, seg.c.y, seg.d.y, s),
+				 horner(seg.a.z, seg.b.z, seg.c.z, seg.d.z, s) };
+	}
+
+	Vector_3d Spline::get_tangent(float t) const
+	{
+		if (segments.empty())
+		{
+			return Vector_3d();
+		}
+		float s;
+		const Segment& seg = segments[locate(t, s)];
+		// dp/dt = dp/ds * segments number
+		const float scale = static_cast<float>(segments.size());
+		return { scale * horner_derivative(seg.b.x, seg.c.x, seg.d.x, s),
+				 scale * horner_derivative(seg.b.y, seg.c.y, seg.d.y, s),
+				 scale * horner_derivative(seg.b.z, seg.c.z, seg.d.z, s) };
+	}
+
+	void Spline::sample(float t0, float t1, size_t count, Vector_3d* out) const
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		const float delta = count > 1 ? (t1 - t0) / static_cast<float>(count - 1) : 0.0f;
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = get_point(t0 + delta * static_cast<float>(i));
+		}
+	}
+
+	void Spline::sample_tangents(float t0, float t1, size_t count, Vector_3d* out) const
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		const float delta = count > 1 ? (t1 - t0) / static_cast<float>(count - 1) : 0.0f;
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = get_tangent(t0 + delta * static_cast<float>(i));
+		}
+	}
+}
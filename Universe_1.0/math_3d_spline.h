@@ -0,0 +1,88 @@
+/******************************************************************************
+	 * File: math_3d_spline.h
+	 * Description: Contains piecewise cubic curves for 3D.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <vector>
+
+#include "math_3d.h"
+
+namespace Math_3d
+{
+	/**
+	* @class Spline
+	* Piecewise cubic curve. Each segment depends on 4 control points
+	* only and is stored in power basis, so a point costs segment
+	* lookup (one multiplication) and 3 multiply-adds per coordinate,
+	* whatever the number of control points.
+	* Parameter t in [0, 1] is spread uniformly over segments.
+	*/
+	class Spline
+	{
+	public:
+		enum class Type
+		{
+			/**
+			 * Control points 3 * k + 1: P0 P1 P2 P3, then P3 P4 P5 P6, ...
+			 * Trailing points which do not complete a segment are ignored.
+			 */
+			cubic_bezier,
+			/**
+			 * Passes through every control point
+			 */
+			catmull_rom,
+			/**
+			 * Uniform cubic B-spline, C2 smooth, passes through
+			 * first and last control points only
+			 */
+			b_spline
+		};
+
+	private:
+		/**
+		 * p(s) = a + s * (b + s * (c + s * d)), s in [0, 1]
+		 */
+		struct Segment
+		{
+			Vector_3d a;
+			Vector_3d b;
+			Vector_3d c;
+			Vector_3d d;
+		};
+
+		std::vector<Segment> segments;
+
+		/**
+		 * Segment index and local parameter for t
+		 */
+		size_t locate(float t, float& s) const;
+
+	public:
+		Spline() {};
+		Spline(const std::vector<Vector_3d>& control_points, Type type);
+
+		size_t get_segments_number() const;
+
+		Vector_3d get_point(float t) const;
+		/**
+		 * Derivative by t, not normalized
+		 */
+		Vector_3d get_tangent(float t) const;
+
+		/**
+		 * out[i] = get_point(t0 + i * (t1 - t0) / (count - 1))
+		 */
+		void sample(float t0, float t1, size_t count, Vector_3d* out) const;
+		/**
+		 * out[i] = get_tangent(t0 + i * (t1 - t0) / (count - 1))
+		 */
+		void sample_tangents(float t0, float t1, size_t count, Vector_3d* out) const;
+	};
+}
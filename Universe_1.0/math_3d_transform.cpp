@@ -0,0 +1,109 @@
+/******************************************************************************
+	 * File: math_3d_transform.cpp
+	 * Description: Contains object placement in world for 3D.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <math.h>
+
+#include "math_3d_transform.h"
+
+namespace Math_3d
+{
+	void Transform::update() const
+	{
+		// Rows of rotation are images of axes: S * R scales rows,
+		// (S * R)^-T = S^-1 * R divides them
+		const Rotation rotation_only(rotation);
+		const Matrix_4x4& rotation_matrix = rotation_only.get_matrix();
+		const float factors[3] = { scale.x, scale.y, scale.z };
+		for (int i = 0; i < 3; ++i)
+		{
+			const float inverse_factor = factors[i] != 0.0f ? 1.0f / factors[i] : 0.0f;
+			for (int j = 0; j < 3; ++j)
+			{
+				world.m[i][j] = rotation_matrix.m[i][j] * factors[i];
+				normal_matrix.m[i][j] = rotation_matrix.m[i][j] * inverse_factor;
+			}
+		}
+		world.m[3][0] = position.x;
+		world.m[3][1] = position.y;
+		world.m[3][2] = position.z;
+		dirty = false;
+	}
+
+	void Transform::set_position(const Vector_3d& position)
+	{
+		this->position = position;
+		dirty = true;
+	}
+
+	void Transform::translate(const Vector_3d& offset)
+	{
+		position = Vector_3d(position.x + offset.x, position.y + offset.y, position.z + offset.z);
+		dirty = true;
+	}
+
+	void Transform::set_rotation(const Quaternion& rotation)
+	{
+		this->rotation = rotation;
+		this->rotation.normalize();
+		dirty = true;
+	}
+
+	void Transform::rotate(const Quaternion& quaternion)
+	{
+		// Products drift from unit length
+		rotation = quaternion * rotation;
+		rotation.normalize();
+		dirty = true;
+	}
+
+	void Transform::set_scale(const Vector_3d& scale)
+	{
+		this->scale = scale;
+		dirty = true;
+	}
+
+	const Vector_3d& Transform::get_position() const
+	{
+		return position;
+	}
+
+	const Quaternion& Transform::get_rotation() const
+	{
+		return rotation;
+	}
+
+	const Vector_3d& Transform::get_scale() const
+	{
+		return scale;
+	}
+
+	float Transform::get_max_scale() const
+	{
+		return fmaxf(fabsf(scale.x), fmaxf(fabsf(scale.y), fabsf(scale.z)));
+	}
+
+	const Matrix_4x4& Transform::get_matrix() const
+	{
+		if (dirty)
+		{
+			update();
+		}
+		return world;
+	}
+
+	const Matrix_4x4& Transform::get_normal_matrix() const
+	{
+		if (dirty)
+		{
+			update();
+		}
+		return normal_matrix;
+	}
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+	 * File: math_3d_transform.h
+	 * Description: Contains object placement in world for 3D.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+
+#include "math_3d.h"
+#include "math_3d_matrix.h"
+#include "math_3d_rotation.h"
+
+namespace Math_3d
+{
+	/**
+	* @class Transform
+	* Scale, then rotation, then translation of object.
+	* Setters only store values and mark matrices dirty,
+	* matrices are rebuilt on first read after change.
+	*/
+	class Transform
+	{
+		Vector_3d position = Vector_3d(0.0f, 0.0f, 0.0f);
+		Quaternion rotation;
+		Vector_3d scale = Vector_3d(1.0f, 1.0f, 1.0f);
+
+		mutable Matrix_4x4 world;
+		mutable Matrix_4x4 normal_matrix;
+		mutable bool dirty = false;
+
+		void update() const;
+
+	public:
+		Transform() {};
+
+		void set_position(const Vector_3d& position);
+		void translate(const Vector_3d& offset);
+		/**
+		 * Rotation is normalized
+		 */
+		void set_rotation(const Quaternion& rotation);
+		/**
+		 * Rotate by quaternion after current rotation
+		 */
+		void rotate(const Quaternion& quaternion);
+		void set_scale(const Vector_3d& scale);
+
+		const Vector_3d& get_position() const;
+		const Quaternion& get_rotation() const;
+		const Vector_3d& get_scale() const;
+		/**
+		 * Largest stretch of any length, for bounding spheres
+		 */
+		float get_max_scale() const;
+
+		/**
+		 * Object to world in row-vector form (v * M)
+		 */
+		const Matrix_4x4& get_matrix() const;
+		/**
+		 * Inverse transpose of get_matrix without translation,
+		 * keeps normals perpendicular under non-uniform scale
+		 */
+		const Matrix_4x4& get_normal_matrix() const;
+	};
+}
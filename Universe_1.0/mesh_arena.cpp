@@ -0,0 +1,124 @@
+/******************************************************************************
+	 * File: mesh_arena.cpp
+	 * Description: Contains arena allocator for mesh buffers.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <cstddef>
+
+#include "mesh_arena.h"
+
+namespace Geometry
+{
+	namespace
+	{
+		// Alignment of new char[], blocks start with it
+		const size_t block_alignment = alignof(std::max_align_t);
+	}
+
+	Mesh_Arena::Mesh_Arena(size_t block_size)
+	: block_size(block_size) {}
+
+	void* Mesh_Arena::allocate(size_t bytes, size_t alignment)
+	{
+		if (bytes == 0)
+		{
+			bytes = 1;
+		}
+		if (alignment > block_alignment)
+		{
+			throw std::bad_alloc();
+		}
+
+		std::lock_guard<std::mutex> lock(arena_mutex);
+		++allocations;
+
+		if (!blocks.empty())
+		{
+			Block& block = blocks.back();
+			size_t offset = (block.used + alignment - 1) / alignment * alignment;
+			if (offset + bytes <= block.size)
+			{
+				block.used = offset + bytes;
+				return block.memory.get() + offset;
+			}
+		}
+
+		// Oversized request gets own block, current one stays open
+		Block block;
+		block.size = bytes > block_size ? bytes : block_size;
+		block.memory.reset(new char[block.size]);
+		block.used = bytes;
+		char* result = block.memory.get();
+		if (bytes > block_size && !blocks.empty())
+		{
+			blocks.insert(blocks.end() - 1, std::move(block));
+		}
+		else
+		{
+			blocks.push_back(std::move(block));
+		}
+		return result;
+	}
+
+	void Mesh_Arena::deallocate(void* ptr, size_t bytes)
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+		if (bytes == 0)
+		{
+			bytes = 1;
+		}
+
+		std::lock_guard<std::mutex> lock(arena_mutex);
+		if (blocks.empty())
+		{
+			return;
+		}
+		Block& block = blocks.back();
+		if (static_cast<char*>(ptr) + bytes == block.memory.get() + block.used)
+		{
+			block.used -= bytes;
+		}
+	}
+
+	size_t Mesh_Arena::get_blocks_number() const
+	{
+		std::lock_guard<std::mutex> lock(arena_mutex);
+		return blocks.size();
+	}
+
+	size_t Mesh_Arena::get_allocations_number() const
+	{
+		std::lock_guard<std::mutex> lock(arena_mutex);
+		return allocations;
+	}
+
+	size_t Mesh_Arena::get_used() const
+	{
+		std::lock_guard<std::mutex> lock(arena_mutex);
+		size_t used = 0;
+		for (const Block& block : blocks)
+		{
+			used += block.used;
+		}
+		return used;
+	}
+
+	size_t Mesh_Arena::get_reserved() const
+	{
+		std::lock_guard<std::mutex> lock(arena_mutex);
+		size_t reserved = 0;
+		for (const Block& block : blocks)
+		{
+			reserved += block.size;
+		}
+		return reserved;
+	}
+}
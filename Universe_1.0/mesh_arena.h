@@ -0,0 +1,120 @@
+/******************************************************************************
+	 * File: mesh_arena.h
+	 * Description: Contains arena allocator for mesh buffers.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Geometry
+{
+	/**
+	* @class Mesh_Arena
+	* Bump allocator for mesh buffers of a whole scene.
+	* Memory is taken from the system in large blocks and returned
+	* only when arena is destroyed, so arena must outlive every
+	* container which uses it. Freeing the latest allocation of a block
+	* gives its memory back, other frees are ignored.
+	* Allocation is thread-safe.
+	*/
+	class Mesh_Arena
+	{
+		struct Block
+		{
+			std::unique_ptr<char[]> memory;
+			size_t size = 0;
+			size_t used = 0;
+		};
+
+		std::vector<Block> blocks;
+		size_t block_size;
+		size_t allocations = 0;
+		mutable std::mutex arena_mutex;
+
+	public:
+		explicit Mesh_Arena(size_t block_size = 4 << 20);
+
+		Mesh_Arena(const Mesh_Arena&) = delete;
+		Mesh_Arena& operator=(const Mesh_Arena&) = delete;
+
+		void* allocate(size_t bytes, size_t alignment);
+		void deallocate(void* ptr, size_t bytes);
+
+		size_t get_blocks_number() const;
+		size_t get_allocations_number() const;
+		/**
+		 * Bytes given out, including alignment padding
+		 */
+		size_t get_used() const;
+		/**
+		 * Bytes taken from the system
+		 */
+		size_t get_reserved() const;
+	};
+
+	/**
+	* @class Arena_Allocator
+	* STL allocator on top of Mesh_Arena.
+	* Default constructed one (no arena) uses operator new.
+	*/
+	template<class T>
+	class Arena_Allocator
+	{
+		template<class U> friend class Arena_Allocator;
+
+		Mesh_Arena* arena = nullptr;
+
+	public:
+		using value_type = T;
+
+		Arena_Allocator() noexcept {};
+		explicit Arena_Allocator(Mesh_Arena* arena) noexcept : arena(arena) {};
+		template<class U>
+		Arena_Allocator(const Arena_Allocator<U>& other) noexcept : arena(other.arena) {};
+
+		T* allocate(size_t count)
+		{
+			if (arena == nullptr)
+			{
+				return static_cast<T*>(::operator new(count * sizeof(T)));
+			}
+			return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* ptr, size_t count) noexcept
+		{
+			if (arena == nullptr)
+			{
+				::operator delete(ptr);
+				return;
+			}
+			arena->deallocate(ptr, count * sizeof(T));
+		}
+
+		Mesh_Arena* get_arena() const noexcept
+		{
+			return arena;
+		}
+
+		template<class U>
+		bool operator==(const Arena_Allocator<U>& other) const noexcept
+		{
+			return arena == other.arena;
+		}
+
+		template<class U>
+		bool operator!=(const Arena_Allocator<U>& other) const noexcept
+		{
+			return arena != other.arena;
+		}
+	};
+}
@@ -0,0 +1,218 @@
+/******************************************************************************
+	 * File: mesh_cleanup.cpp
+	 * Description: Contains welding and compaction of generated meshes.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "mesh_cleanup.h"
+
+namespace Geometry
+{
+	namespace
+	{
+		const uint32_t no_vertex = 0xFFFFFFFFu;
+
+		size_t get_bytes(const Object_Data& data)
+		{
+			size_t vertex_size = data.format == Vertex_Format::full ? sizeof(Vertex) : sizeof(Compact_Vertex);
+			return data.vertices.size() * vertex_size + data.indices.get_bytes();
+		}
+
+		/**
+		 * Hash of integer cell coordinates
+		 */
+		size_t hash_cell(int64_t x, int64_t y, int64_t z)
+		{
+			uint64_t hash = static_cast<uint64_t>(x) * 73856093u;
+			hash ^= static_cast<uint64_t>(y) * 19349663u;
+			hash ^= static_cast<uint64_t>(z) * 83492791u;
+			return static_cast<size_t>(hash ^ (hash >> 29));
+		}
+
+		/**
+		 * remap[v] = first vertex equal to v within tolerances, v itself if none
+		 */
+		std::vector<uint32_t> weld(const Object_Data& data, const Cleanup_Options& options)
+		{
+			const size_t count = data.vertices.size();
+			std::vector<uint32_t> remap(count);
+			const float tolerance = options.position_tolerance;
+			const float tolerance_sq = tolerance * tolerance;
+			const float min_cos = cosf(Math_3d::degree_to_radian(options.normal_tolerance));
+			// Cell of twice tolerance size, equal vertices are in same cell
+			// or in neighbour one on the nearer side along each axis.
+			// Without tolerance cell is exact position bits.
+			const bool exact = !(tolerance > 0.0f);
+			const float inv_cell = exact ? 0.0f : 0.5f / tolerance;
+
+			// Chained hash of representatives: heads per bucket, next per vertex
+			size_t buckets = 1;
+			while (buckets < count * 2)
+			{
+				buckets <<= 1;
+			}
+			std::vector<uint32_t> heads(buckets, no_vertex);
+			std::vector<uint32_t> next(count, no_vertex);
+
+			auto same = [&](const Vertex& a, const Vertex& b) -> bool
+			{
+				const float dx = a.pos.x - b.pos.x, dy = a.pos.y - b.pos.y, dz = a.pos.z - b.pos.z;
+				if (dx * dx + dy * dy + dz * dz > tolerance_sq)
+				{
+					return false;
+				}
+				const float normal_dot = a.normal.x * b.normal.x + a.normal.y * b.normal.y + a.normal.z * b.normal.z;
+				const float normals_sq = (a.normal & a.normal) * (b.normal & b.normal);
+				// Zero normals match each other only
+				if (normals_sq == 0.0f)
+				{
+					return (a.normal & a.normal) == (b.normal & b.normal);
+				}
+				return normal_dot >= min_cos * sqrtf(normals_sq);
+			};
+
+			for (size_t v = 0; v < count; ++v)
+			{
+				const Vertex& vertex = data.vertices[v];
+				const float pos[3] = { vertex.pos.x, vertex.pos.y, vertex.pos.z };
+				int64_t cells[3];
+				int64_t nearer[3] = { 0, 0, 0 };
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					if (exact)
+					{
+						// Adding zero turns -0 to +0, they are equal
+						const float value = pos[axis] + 0.0f;
+						uint32_t bits;
+						memcpy(&bits, &value, sizeof(bits));
+						cells[axis] = bits;
+						continue;
+					}
+					const float scaled = pos[axis] * inv_cell;
+					const float cell = floorf(scaled);
+					cells[axis] = static_cast<int64_t>(cell);
+					nearer[axis] = scaled - cell < 0.5f ? -1 : 1;
+				}
+
+				uint32_t found = no_vertex;
+				const int neighbours = exact ? 1 : 8;
+				for (int neighbour = 0; neighbour < neighbours && found == no_vertex; ++neighbour)
+				{
+					const int64_t x = cells[0] + (neighbour & 1 ? nearer[0] : 0);
+					const int64_t y = cells[1] + (neighbour & 2 ? nearer[1] : 0);
+					const int64_t z = cells[2] + (neighbour & 4 ? nearer[2] : 0);
+					uint32_t other = heads[hash_cell(x, y, z) & (buckets - 1)];
+					for (; other != no_vertex; other = next[other])
+					{
+						if (same(vertex, data.vertices[other]))
+						{
+							found = other;
+							break;
+						}
+					}
+				}
+
+				if (found != no_vertex)
+				{
+					remap[v] = found;
+					continue;
+				}
+				remap[v] = static_cast<uint32_t>(v);
+				size_t bucket = hash_cell(cells[0], cells[1], cells[2]) & (buckets - 1);
+				next[v] = heads[bucket];
+				heads[bucket] = static_cast<uint32_t>(v);
+			}
+			return remap;
+		}
+
+		bool is_degenerate(const Math_3d::Vector_3d& a, const Math_3d::Vector_3d& b, const Math_3d::Vector_3d& c,
+						   float tolerance_sq)
+		{
+			const Math_3d::Vector_3d ab = b - a;
+			const Math_3d::Vector_3d ac = c - a;
+			const Math_3d::Vector_3d bc = c - b;
+			const Math_3d::Vector_3d cross = ab ^ ac;
+			// Height to longest edge: |cross| / |edge| < tolerance
+			float edge_sq = ab & ab;
+			edge_sq = (ac & ac) > edge_sq ? (ac & ac) : edge_sq;
+			edge_sq = (bc & bc) > edge_sq ? (bc & bc) : edge_sq;
+			return (cross & cross) <= tolerance_sq * edge_sq;
+		}
+	}
+
+	Cleanup_Stats clean_mesh(Object_Data& data, const Cleanup_Options& options)
+	{
+		Cleanup_Stats stats;
+		stats.vertices_before = data.vertices.size();
+		stats.triangles_before = data.indices.size() / 3;
+		stats.bytes_before = get_bytes(data);
+
+		std::vector<uint32_t> remap = weld(data, options);
+		for (size_t v = 0; v < remap.size(); ++v)
+		{
+			stats.welded_vertices += remap[v] != v ? 1 : 0;
+		}
+
+		// Triangles are moved down in place
+		const float tolerance_sq = options.position_tolerance * options.position_tolerance;
+		std::vector<bool> used(data.vertices.size(), false);
+		size_t triangles = 0;
+		for (size_t triangle = 0; triangle < stats.triangles_before; ++triangle)
+		{
+			uint32_t a = remap[data.indices[triangle * 3]];
+			uint32_t b = remap[data.indices[triangle * 3 + 1]];
+			uint32_t c = remap[data.indices[triangle * 3 + 2]];
+			if (a == b || b == c || a == c ||
+				is_degenerate(data.vertices[a].pos, data.vertices[b].pos, data.vertices[c].pos, tolerance_sq))
+			{
+				++stats.degenerate_triangles;
+				continue;
+			}
+			data.indices.set(triangles * 3, a);
+			data.indices.set(triangles * 3 + 1, b);
+			data.indices.set(triangles * 3 + 2, c);
+			used[a] = used[b] = used[c] = true;
+			++triangles;
+		}
+		data.indices.resize(triangles * 3);
+
+		// Kept vertices move down in place, new index never exceeds old one
+		std::vector<uint32_t> new_index(data.vertices.size(), no_vertex);
+		size_t vertices = 0;
+		for (size_t v = 0; v < data.vertices.size(); ++v)
+		{
+			if (!used[v])
+			{
+				stats.unused_vertices += remap[v] == v ? 1 : 0;
+				continue;
+			}
+			new_index[v] = static_cast<uint32_t>(vertices);
+			data.vertices[vertices++] = data.vertices[v];
+		}
+		data.vertices.resize(vertices);
+		for (size_t i = 0; i < data.indices.size(); ++i)
+		{
+			data.indices.set(i, new_index[data.indices[i]]);
+		}
+		data.indices.set_vertex_count(vertices);
+		data.size = data.indices.size();
+		data.set_vertex_format(data.format);
+		// Ranges of levels and meshlets point to old indices
+		data.lods.clear();
+		data.meshlets.clear();
+
+		stats.vertices_after = data.vertices.size();
+		stats.triangles_after = triangles;
+		stats.bytes_after = get_bytes(data);
+		return stats;
+	}
+}
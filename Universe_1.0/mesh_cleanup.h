@@ -0,0 +1,62 @@
+/******************************************************************************
+	 * File: mesh_cleanup.h
+	 * Description: Contains welding and compaction of generated meshes.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+
+#include "geometry.h"
+
+namespace Geometry
+{
+	/**
+	* @struct Cleanup_Options
+	* Vertices closer than position_tolerance with normals closer
+	* than normal_tolerance (degrees) are welded, so hard edges
+	* such as cap rims stay. Triangle is degenerate if it uses a
+	* vertex twice after welding or its height is below position_tolerance.
+	*/
+	struct Cleanup_Options
+	{
+		float position_tolerance = 1e-5f;
+		float normal_tolerance = 1.0f;
+	};
+
+	/**
+	* @struct Cleanup_Stats
+	* Mesh before and after clean_mesh
+	*/
+	struct Cleanup_Stats
+	{
+		size_t vertices_before = 0;
+		size_t vertices_after = 0;
+		size_t triangles_before = 0;
+		size_t triangles_after = 0;
+		size_t welded_vertices = 0;
+		size_t unused_vertices = 0;
+		size_t degenerate_triangles = 0;
+		/**
+		 * Vertex and index buffers as uploaded
+		 */
+		size_t bytes_before = 0;
+		size_t bytes_after = 0;
+	};
+
+	/**
+	 * Weld vertices (spatial hash of cells twice tolerance in size,
+	 * exact positions when tolerance is 0),
+	 * drop degenerate triangles, then drop vertices no triangle uses.
+	 * Vertices and triangles keep their order, buffers are compacted
+	 * in place, indices narrow to 16 bit when vertices fit,
+	 * compact vertices are encoded again.
+	 * Levels of detail and meshlets are cleared, their ranges
+	 * are stale, so clean mesh before make_lods and build_meshlets.
+	 */
+	Cleanup_Stats clean_mesh(Object_Data& data, const Cleanup_Options& options = Cleanup_Options());
+}
@@ -0,0 +1,444 @@
+/******************************************************************************
+	 * File: mesh_optimizer.cpp
+	 * Description: Contains triangle and vertex reordering for GPU caches.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <math.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+#include "mesh_optimizer.h"
+
+namespace Geometry
+{
+	namespace
+	{
+		const uint32_t no_triangle = 0xFFFFFFFFu;
+		const uint32_t no_vertex = 0xFFFFFFFFu;
+
+		// Forsyth scoring constants
+		const size_t max_cache_size = 64;
+		const float cache_decay_power = 1.5f;
+		const float last_triangle_score = 0.75f;
+		const float valence_boost_scale = 2.0f;
+		const float valence_boost_power = 0.5f;
+		// Valences with score in table, larger ones are computed
+		const uint32_t max_valence = 32;
+
+		/**
+		 * Score of vertex by position in LRU cache (-1 if not there)
+		 * and number of triangles not emitted yet
+		 */
+		class Vertex_Score
+		{
+			float position_scores[max_cache_size + 3];
+			float valence_scores[max_valence + 1];
+
+		public:
+			explicit Vertex_Score(size_t cache_size)
+			{
+				for (size_t i = 0; i < cache_size; ++i)
+				{
+					if (i < 3)
+					{
+						// Vertices of last triangle, fixed score
+						// so it is not used again at once
+						position_scores[i] = last_triangle_score;
+					}
+					else
+					{
+						const float scale = 1.0f / static_cast<float>(cache_size - 3);
+						position_scores[i] = powf(1.0f - static_cast<float>(i - 3) * scale, cache_decay_power);
+					}
+				}
+				valence_scores[0] = 0.0f;
+				for (uint32_t i = 1; i <= max_valence; ++i)
+				{
+					valence_scores[i] = valence_boost_scale * powf(static_cast<float>(i), -valence_boost_power);
+				}
+			}
+
+			float get(int cache_position, uint32_t live_triangles) const
+			{
+				if (live_triangles == 0)
+				{
+					return -1.0f;
+				}
+				float score = cache_position >= 0 ? position_scores[cache_position] : 0.0f;
+				score += live_triangles <= max_valence ? valence_scores[live_triangles] :
+							 valence_boost_scale * powf(static_cast<float>(live_triangles), -valence_boost_power);
+				return score;
+			}
+		};
+
+		template<class Index>
+		Cache_Stats analyze_vertex_cache(const Index* indices, size_t indices_number, size_t vertices_number,
+										 size_t cache_size)
+		{
+			Cache_Stats stats;
+			if (indices_number < 3 || cache_size == 0)
+			{
+				return stats;
+			}
+
+			// Vertex is in FIFO if it was inserted during last cache_size misses
+			std::vector<uint32_t> timestamps(vertices_number, 0);
+			uint32_t time = static_cast<uint32_t>(cache_size) + 1;
+			size_t used_vertices = 0;
+			for (size_t i = 0; i < indices_number; ++i)
+			{
+				const Index vertex = indices[i];
+				used_vertices += timestamps[vertex] == 0 ? 1 : 0;
+				if (time - timestamps[vertex] > cache_size)
+				{
+					timestamps[vertex] = time++;
+					++stats.transformed_vertices;
+				}
+			}
+			stats.acmr = static_cast<float>(stats.transformed_vertices) / static_cast<float>(indices_number / 3);
+			stats.atvr = static_cast<float>(stats.transformed_vertices) / static_cast<float>(used_vertices);
+			return stats;
+		}
+
+		template<class Index>
+		void optimize_vertex_cache(Index* indices, size_t indices_number, size_t vertices_number, size_t cache_size)
+		{
+			const size_t triangles_number = indices_number / 3;
+			const Vertex_Score vertex_score(cache_size);
+
+			// CSR vertex -> triangles not emitted yet: adjacency[offsets[v] .. offsets[v] + live[v])
+			std::vector<uint32_t> live(vertices_number, 0);
+			for (size_t i = 0; i < triangles_number * 3; ++i)
+			{
+				++live[indices[i]];
+			}
+			std::vector<uint32_t> offsets(vertices_number + 1, 0);
+			for (size_t v = 0; v < vertices_number; ++v)
+			{
+				offsets[v + 1] = offsets[v] + live[v];
+			}
+			std::vector<uint32_t> adjacency(triangles_number * 3);
+			{
+				std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+				for (size_t i = 0; i < triangles_number * 3; ++i)
+				{
+					adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+				}
+			}
+
+			std::vector<int> cache_positions(vertices_number, -1);
+			std::vector<float> vertex_scores(vertices_number);
+			for (size_t v = 0; v < vertices_number; ++v)
+			{
+				vertex_scores[v] = vertex_score.get(-1, live[v]);
+			}
+			std::vector<float> triangle_scores(triangles_number);
+			uint32_t current = no_triangle;
+			float best_score = -1.0f;
+			for (size_t triangle = 0; triangle < triangles_number; ++triangle)
+			{
+				const Index* corners = indices + triangle * 3;
+				triangle_scores[triangle] = vertex_scores[corners[0]] + vertex_scores[corners[1]] + vertex_scores[corners[2]];
+				if (triangle_scores[triangle] > best_score)
+				{
+					best_score = triangle_scores[triangle];
+					current = static_cast<uint32_t>(triangle);
+				}
+			}
+
+			std::vector<Index> result(triangles_number * 3);
+			std::vector<bool> emitted(triangles_number, false);
+			uint32_t cache[max_cache_size + 3];
+			uint32_t new_cache[max_cache_size + 3];
+			size_t cache_count = 0;
+			size_t next_unemitted = 0;
+
+			for (size_t output = 0; output < triangles_number; ++output)
+			{
+				// Dead end, no triangle touches cache: take next in input order
+				if (current == no_triangle)
+				{
+					while (emitted[next_unemitted])
+					{
+						++next_unemitted;
+					}
+					current = static_cast<uint32_t>(next_unemitted);
+				}
+
+				const Index* corners = indices + current * 3;
+				std::copy(corners, corners + 3, result.begin() + output * 3);
+				emitted[current] = true;
+
+				// Emitted vertices to cache front, rest moves back
+				size_t new_count = 0;
+				for (int i = 0; i < 3; ++i)
+				{
+					const uint32_t vertex = corners[i];
+					if (std::find(new_cache, new_cache + new_count, vertex) == new_cache + new_count)
+					{
+						new_cache[new_count++] = vertex;
+					}
+
+					// Triangle leaves adjacency of its vertices
+					uint32_t* begin = &adjacency[offsets[vertex]];
+					uint32_t* end = begin + live[vertex];
+					uint32_t* found = std::find(begin, end, current);
+					*found = *(end - 1);
+					--live[vertex];
+				}
+				for (size_t i = 0; i < cache_count; ++i)
+				{
+					const uint32_t vertex = cache[i];
+					if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2])
+					{
+						new_cache[new_count++] = vertex;
+					}
+				}
+
+				// Rescore vertices of new cache and the ones pushed out of it
+				for (size_t i = 0; i < new_count; ++i)
+				{
+					const uint32_t vertex = new_cache[i];
+					cache_positions[vertex] = i < cache_size ? static_cast<int>(i) : -1;
+					const float score = vertex_score.get(cache_positions[vertex], live[vertex]);
+					const float delta = score - vertex_scores[vertex];
+					vertex_scores[vertex] = score;
+					for (uint32_t j = offsets[vertex]; j < offsets[vertex] + live[vertex]; ++j)
+					{
+						triangle_scores[adjacency[j]] += delta;
+					}
+				}
+				cache_count = new_count < cache_size ? new_count : cache_size;
+				std::copy(new_cache, new_cache + cache_count, cache);
+
+				// Next is best triangle of cached vertices
+				current = no_triangle;
+				best_score = -1.0f;
+				for (size_t i = 0; i < cache_count; ++i)
+				{
+					const uint32_t vertex = cache[i];
+					for (uint32_t j = offsets[vertex]; j < offsets[vertex] + live[vertex]; ++j)
+					{
+						const uint32_t triangle = adjacency[j];
+						if (triangle_scores[triangle] > best_score)
+						{
+							best_score = triangle_scores[triangle];
+							current = triangle;
+						}
+					}
+				}
+			}
+			std::copy(result.begin(), result.end(), indices);
+		}
+
+		template<class Index>
+		void optimize_overdraw(Index* indices, size_t indices_number, const Vertex* vertices, size_t vertices_number,
+							   float threshold, size_t cache_size)
+		{
+			const size_t triangles_number = indices_number / 3;
+
+			// Cache misses per triangle in FIFO of cache_size
+			std::vector<uint8_t> misses(triangles_number);
+			std::vector<uint32_t> timestamps(vertices_number, 0);
+			uint32_t time = static_cast<uint32_t>(cache_size) + 1;
+			for (size_t triangle = 0; triangle < triangles_number; ++triangle)
+			{
+				misses[triangle] = 0;
+				for (int i = 0; i < 3; ++i)
+				{
+					const Index vertex = indices[triangle * 3 + i];
+					if (time - timestamps[vertex] > cache_size)
+					{
+						timestamps[vertex] = time++;
+						++misses[triangle];
+					}
+				}
+			}
+
+			// Hard clusters start where all three vertices miss, cache order
+			// starts over there and moving them costs nothing.
+			// Soft clusters split hard ones where ACMR so far is
+			// close enough to ACMR of the hard cluster
+			std::vector<uint32_t> clusters;
+			size_t hard_begin = 0;
+			while (hard_begin < triangles_number)
+			{
+				size_t hard_end = hard_begin + 1;
+				size_t hard_misses = misses[hard_begin];
+				while (hard_end < triangles_number && misses[hard_end] != 3)
+				{
+					hard_misses += misses[hard_end++];
+				}
+				const float hard_acmr = static_cast<float>(hard_misses) / static_cast<float>(hard_end - hard_begin);
+
+				clusters.push_back(static_cast<uint32_t>(hard_begin));
+				size_t soft_misses = 0;
+				size_t soft_triangles = 0;
+				for (size_t triangle = hard_begin; triangle + 1 < hard_end; ++triangle)
+				{
+					soft_misses += misses[triangle];
+					++soft_triangles;
+					if (static_cast<float>(soft_misses) <= threshold * hard_acmr * static_cast<float>(soft_triangles))
+					{
+						clusters.push_back(static_cast<uint32_t>(triangle + 1));
+						// New cluster starts with cold cache
+						soft_misses = 3 - misses[triangle + 1];
+						soft_triangles = 0;
+					}
+				}
+				hard_begin = hard_end;
+			}
+			clusters.push_back(static_cast<uint32_t>(triangles_number));
+
+			// Area weighted centroid and normal of clusters and whole mesh
+			const size_t clusters_number = clusters.size() - 1;
+			std::vector<Math_3d::Vector_3d> centroids(clusters_number);
+			std::vector<Math_3d::Vector_3d> normals(clusters_number);
+			Math_3d::Vector_3d mesh_centroid(0.0f, 0.0f, 0.0f);
+			float mesh_area = 0.0f;
+			for (size_t cluster = 0; cluster < clusters_number; ++cluster)
+			{
+				Math_3d::Vector_3d centroid(0.0f, 0.0f, 0.0f);
+				Math_3d::Vector_3d normal(0.0f, 0.0f, 0.0f);
+				float area = 0.0f;
+				for (size_t triangle = clusters[cluster]; triangle < clusters[cluster + 1]; ++triangle)
+				{
+					const Math_3d::Vector_3d& a = vertices[indices[triangle * 3]].pos;
+					const Math_3d::Vector_3d& b = vertices[indices[triangle * 3 + 1]].pos;
+					const Math_3d::Vector_3d& c = vertices[indices[triangle * 3 + 2]].pos;
+					const Math_3d::Vector_3d cross = (b - a) ^ (c - a);
+					const float triangle_area = sqrtf(cross & cross);
+					centroid = centroid + (a + b + c) * (triangle_area / 3.0f);
+					normal = normal + cross;
+					area += triangle_area;
+				}
+				mesh_centroid = mesh_centroid + centroid;
+				mesh_area += area;
+				centroids[cluster] = area > 0.0f ? centroid * (1.0f / area) : centroid;
+				normals[cluster] = normal;
+			}
+			if (mesh_area > 0.0f)
+			{
+				mesh_centroid = mesh_centroid * (1.0f / mesh_area);
+			}
+
+			// Clusters facing away from mesh center first
+			std::vector<float> sort_keys(clusters_number);
+			std::vector<uint32_t> order(clusters_number);
+			for (size_t cluster = 0; cluster < clusters_number; ++cluster)
+			{
+				const Math_3d::Vector_3d& normal = normals[cluster];
+				const float length = sqrtf(normal & normal);
+				sort_keys[cluster] = length > 0.0f ? ((centroids[cluster] - mesh_centroid) & normal) / length : 0.0f;
+				order[cluster] = static_cast<uint32_t>(cluster);
+			}
+			std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+			{
+				return sort_keys[a] > sort_keys[b];
+			});
+
+			std::vector<Index> result;
+			result.reserve(triangles_number * 3);
+			for (uint32_t cluster : order)
+			{
+				result.insert(result.end(), indices + clusters[cluster] * 3, indices + clusters[cluster + 1] * 3);
+			}
+			std::copy(result.begin(), result.end(), indices);
+		}
+
+		template<class Index>
+		std::vector<uint32_t> optimize_vertex_fetch(Index* indices, size_t indices_number, size_t vertices_number)
+		{
+			std::vector<uint32_t> new_index(vertices_number, no_vertex);
+			uint32_t next = 0;
+			for (size_t i = 0; i < indices_number; ++i)
+			{
+				uint32_t& vertex = new_index[indices[i]];
+				if (vertex == no_vertex)
+				{
+					vertex = next++;
+				}
+				indices[i] = static_cast<Index>(vertex);
+			}
+			for (uint32_t& vertex : new_index)
+			{
+				if (vertex == no_vertex)
+				{
+					vertex = next++;
+				}
+			}
+			return new_index;
+		}
+	}
+
+	Cache_Stats analyze_vertex_cache(const Object_Data& data, size_t cache_size)
+	{
+		if (data.indices.is_wide())
+		{
+			return analyze_vertex_cache(data.indices.data_32(), data.indices.size(), data.vertices.size(), cache_size);
+		}
+		return analyze_vertex_cache(data.indices.data_16(), data.indices.size(), data.vertices.size(), cache_size);
+	}
+
+	void optimize_vertex_cache(Object_Data& data, size_t cache_size)
+	{
+		if (data.indices.size() < 6)
+		{
+			return;
+		}
+		cache_size = std::min(std::max(cache_size, size_t(4)), max_cache_size);
+		if (data.indices.is_wide())
+		{
+			optimize_vertex_cache(data.indices.data_32(), data.indices.size(), data.vertices.size(), cache_size);
+		}
+		else
+		{
+			optimize_vertex_cache(data.indices.data_16(), data.indices.size(), data.vertices.size(), cache_size);
+		}
+	}
+
+	void optimize_overdraw(Object_Data& data, float threshold, size_t cache_size)
+	{
+		if (data.indices.size() < 6 || cache_size == 0)
+		{
+			return;
+		}
+		if (data.indices.is_wide())
+		{
+			optimize_overdraw(data.indices.data_32(), data.indices.size(), data.vertices.data(), data.vertices.size(),
+							  threshold, cache_size);
+		}
+		else
+		{
+			optimize_overdraw(data.indices.data_16(), data.indices.size(), data.vertices.data(), data.vertices.size(),
+							  threshold, cache_size);
+		}
+	}
+
+	void optimize_vertex_fetch(Object_Data& data)
+	{
+		std::vector<uint32_t> new_index = data.indices.is_wide() ?
+			optimize_vertex_fetch(data.indices.data_32(), data.indices.size(), data.vertices.size()) :
+			optimize_vertex_fetch(data.indices.data_16(), data.indices.size(), data.vertices.size());
+
+		const std::vector<Vertex> vertices(data.vertices.begin(), data.vertices.end());
+		for (size_t v = 0; v < vertices.size(); ++v)
+		{
+			data.vertices[new_index[v]] = vertices[v];
+		}
+		data.set_vertex_format(data.format);
+	}
+
+	void optimize_mesh(Object_Data& data)
+	{
+		optimize_vertex_cache(data);
+		optimize_overdraw(data);
+		optimize_vertex_fetch(data);
+	}
+}
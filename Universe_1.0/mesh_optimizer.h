@@ -0,0 +1,70 @@
+/******************************************************************************
+	 * File: mesh_optimizer.h
+	 * Description: Contains triangle and vertex reordering for GPU caches.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+
+#include "geometry.h"
+
+namespace Geometry
+{
+	/**
+	* @struct Cache_Stats
+	* Post-transform cache efficiency of index order
+	*/
+	struct Cache_Stats
+	{
+		/**
+		 * Vertex shader invocations per triangle, 0.5 at best
+		 */
+		float acmr = 0.0f;
+		/**
+		 * Vertex shader invocations per used vertex, 1.0 at best
+		 */
+		float atvr = 0.0f;
+		size_t transformed_vertices = 0;
+	};
+
+	/**
+	 * Simulate FIFO post-transform cache of cache_size entries
+	 * over indices of data
+	 */
+	Cache_Stats analyze_vertex_cache(const Object_Data& data, size_t cache_size = 16);
+
+	/**
+	 * Reorder triangles for post-transform cache reuse (Forsyth, 2006):
+	 * greedy emission of the best scored triangle among those of
+	 * vertices in simulated LRU cache of cache_size entries.
+	 * Scores favour recently used vertices and vertices with
+	 * few triangles left, so no vertex is left for long.
+	 */
+	void optimize_vertex_cache(Object_Data& data, size_t cache_size = 32);
+
+	/**
+	 * Reorder clusters of triangles so outward facing ones are drawn
+	 * first and occlude the rest (Sander et al., 2007). Clusters end
+	 * where cache order starts over or, inside those, where ACMR of
+	 * cluster stays within threshold of ACMR of whole mesh.
+	 * Run after optimize_vertex_cache.
+	 */
+	void optimize_overdraw(Object_Data& data, float threshold = 1.05f, size_t cache_size = 16);
+
+	/**
+	 * Order vertices by first use in indices so vertex fetch reads
+	 * memory forward. Unused vertices go last. Compact vertices
+	 * are encoded again.
+	 */
+	void optimize_vertex_fetch(Object_Data& data);
+
+	/**
+	 * Vertex cache, overdraw and vertex fetch passes in that order
+	 */
+	void optimize_mesh(Object_Data& data);
+}
@@ -0,0 +1,286 @@
+/******************************************************************************
+	 * File: meshlets.cpp
+	 * Description: Contains meshlet building and per cluster culling.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+#include "meshlets.h"
+
+namespace Geometry
+{
+	namespace
+	{
+		const uint32_t no_meshlet = 0xFFFFFFFFu;
+
+		/**
+		 * Sphere around box of meshlet vertices and cone of its triangles
+		 */
+		void set_bounds(const Object_Data& data, const std::vector<uint32_t>& vertices, Meshlet& meshlet)
+		{
+			Math_3d::Vector_3d low = data.vertices[vertices[0]].pos;
+			Math_3d::Vector_3d high = low;
+			for (uint32_t vertex : vertices)
+			{
+				const Math_3d::Vector_3d& pos = data.vertices[vertex].pos;
+				low = Math_3d::Vector_3d(fminf(low.x, pos.x), fminf(low.y, pos.y), fminf(low.z, pos.z));
+				high = Math_3d::Vector_3d(fmaxf(high.x, pos.x), fmaxf(high.y, pos.y), fmaxf(high.z, pos.z));
+			}
+			meshlet.center = (low + high) * 0.5f;
+			float radius_sq = 0.0f;
+			for (uint32_t vertex : vertices)
+			{
+				const Math_3d::Vector_3d offset = data.vertices[vertex].pos - meshlet.center;
+				radius_sq = fmaxf(radius_sq, offset & offset);
+			}
+			meshlet.radius = sqrtf(radius_sq);
+
+			// Unit normals of triangles, zero area ones face nowhere
+			std::vector<Math_3d::Vector_3d> normals;
+			normals.reserve(meshlet.indices_number / 3);
+			Math_3d::Vector_3d axis(0.0f, 0.0f, 0.0f);
+			for (uint32_t i = meshlet.first_index; i < meshlet.first_index + meshlet.indices_number; i += 3)
+			{
+				const Math_3d::Vector_3d& a = data.vertices[data.indices[i]].pos;
+				const Math_3d::Vector_3d& b = data.vertices[data.indices[i + 1]].pos;
+				const Math_3d::Vector_3d& c = data.vertices[data.indices[i + 2]].pos;
+				Math_3d::Vector_3d normal = (b - a) ^ (c - a);
+				const float length = sqrtf(normal & normal);
+				if (length == 0.0f)
+				{
+					continue;
+				}
+				normal = normal * (1.0f / length);
+				normals.push_back(normal);
+				axis = axis + normal;
+			}
+
+			meshlet.cone_axis = Math_3d::Vector_3d(0.0f, 0.0f, 0.0f);
+			meshlet.cone_cutoff = 1.0f;
+			const float axis_length = sqrtf(axis & axis);
+			if (axis_length == 0.0f)
+			{
+				return;
+			}
+			axis = axis * (1.0f / axis_length);
+			float min_dot = 1.0f;
+			for (const Math_3d::Vector_3d& normal : normals)
+			{
+				min_dot = fminf(min_dot, normal & axis);
+			}
+			meshlet.cone_axis = axis;
+			// Normals wider than hemisphere always have some triangle facing camera
+			if (min_dot > 0.0f)
+			{
+				meshlet.cone_cutoff = sqrtf(1.0f - min_dot * min_dot);
+			}
+		}
+
+		/**
+		 * canonical[v] = lowest vertex at position of v, so vertices
+		 * split by normal or uv share edges
+		 */
+		std::vector<uint32_t> get_canonical(const Object_Data& data)
+		{
+			auto key = [&](uint32_t vertex, int axis) -> uint32_t
+			{
+				const Math_3d::Vector_3d& pos = data.vertices[vertex].pos;
+				// Adding zero turns -0 to +0, they are equal
+				const float value = (axis == 0 ? pos.x : axis == 1 ? pos.y : pos.z) + 0.0f;
+				uint32_t bits;
+				memcpy(&bits, &value, sizeof(bits));
+				return bits;
+			};
+			auto same_position = [&](uint32_t a, uint32_t b) -> bool
+			{
+				return key(a, 0) == key(b, 0) && key(a, 1) == key(b, 1) && key(a, 2) == key(b, 2);
+			};
+
+			std::vector<uint32_t> order(data.vertices.size());
+			for (size_t v = 0; v < order.size(); ++v)
+			{
+				order[v] = static_cast<uint32_t>(v);
+			}
+			std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+			{
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					if (key(a, axis) != key(b, axis))
+					{
+						return key(a, axis) < key(b, axis);
+					}
+				}
+				return a < b;
+			});
+			std::vector<uint32_t> canonical(order.size());
+			for (size_t i = 0; i < order.size(); ++i)
+			{
+				const bool repeated = i > 0 && same_position(order[i], order[i - 1]);
+				canonical[order[i]] = repeated ? canonical[order[i - 1]] : order[i];
+			}
+			return canonical;
+		}
+
+		/**
+		 * True if some edge of triangles in range is not shared by exactly two of them
+		 */
+		bool has_open_edges(const Object_Data& data, const std::vector<uint32_t>& canonical,
+							size_t first_index, size_t indices_number)
+		{
+			std::vector<uint64_t> edges;
+			edges.reserve(indices_number);
+			for (size_t i = first_index; i + 2 < first_index + indices_number; i += 3)
+			{
+				for (int k = 0; k < 3; ++k)
+				{
+					const uint64_t a = canonical[data.indices[i + k]];
+					const uint64_t b = canonical[data.indices[i + (k + 1) % 3]];
+					if (a != b)
+					{
+						edges.push_back(a < b ? (a << 32) | b : (b << 32) | a);
+					}
+				}
+			}
+			std::sort(edges.begin(), edges.end());
+			for (size_t i = 0; i < edges.size();)
+			{
+				size_t j = i;
+				while (j < edges.size() && edges[j] == edges[i])
+				{
+					++j;
+				}
+				if (j - i != 2)
+				{
+					return true;
+				}
+				i = j;
+			}
+			return false;
+		}
+
+		void build_meshlets(Object_Data& data, size_t first_index, size_t indices_number,
+							size_t max_vertices, size_t max_triangles, std::vector<uint32_t>& owners,
+							const std::vector<uint32_t>& canonical)
+		{
+			const size_t first_meshlet = data.meshlets.size();
+			Meshlet meshlet;
+			meshlet.first_index = static_cast<uint32_t>(first_index);
+			std::vector<uint32_t> vertices;
+			vertices.reserve(max_vertices);
+			uint32_t meshlet_id = static_cast<uint32_t>(data.meshlets.size());
+
+			auto finish = [&]()
+			{
+				meshlet.vertices_number = static_cast<uint32_t>(vertices.size());
+				set_bounds(data, vertices, meshlet);
+				data.meshlets.push_back(meshlet);
+				meshlet.first_index += meshlet.indices_number;
+				meshlet.indices_number = 0;
+				vertices.clear();
+				++meshlet_id;
+			};
+
+			for (size_t i = first_index; i + 2 < first_index + indices_number; i += 3)
+			{
+				const uint32_t corners[3] = { data.indices[i], data.indices[i + 1], data.indices[i + 2] };
+				size_t new_vertices = 0;
+				for (int k = 0; k < 3; ++k)
+				{
+					const bool repeated = (k > 0 && corners[k] == corners[0]) || (k > 1 && corners[k] == corners[1]);
+					new_vertices += owners[corners[k]] != meshlet_id && !repeated ? 1 : 0;
+				}
+				if (vertices.size() + new_vertices > max_vertices || meshlet.indices_number / 3 >= max_triangles)
+				{
+					finish();
+				}
+				for (uint32_t vertex : corners)
+				{
+					if (owners[vertex] != meshlet_id)
+					{
+						owners[vertex] = meshlet_id;
+						vertices.push_back(vertex);
+					}
+				}
+				meshlet.indices_number += 3;
+			}
+			if (meshlet.indices_number > 0)
+			{
+				finish();
+			}
+
+			// Both sides are drawn, so back of open surface is seen
+			// past its border and no meshlet of range may be cone culled
+			if (has_open_edges(data, canonical, first_index, indices_number))
+			{
+				for (size_t i = first_meshlet; i < data.meshlets.size(); ++i)
+				{
+					data.meshlets[i].cone_axis = Math_3d::Vector_3d(0.0f, 0.0f, 0.0f);
+					data.meshlets[i].cone_cutoff = 1.0f;
+				}
+			}
+		}
+	}
+
+	void build_meshlets(Object_Data& data, size_t max_vertices, size_t max_triangles)
+	{
+		data.meshlets.clear();
+		if (max_vertices < 3 || max_triangles < 1)
+		{
+			return;
+		}
+		// Meshlet which took vertex last
+		std::vector<uint32_t> owners(data.vertices.size(), no_meshlet);
+		const std::vector<uint32_t> canonical = get_canonical(data);
+		if (data.lods.empty())
+		{
+			build_meshlets(data, 0, data.indices.size(), max_vertices, max_triangles, owners, canonical);
+			return;
+		}
+		for (Lod_Level& lod : data.lods)
+		{
+			lod.first_meshlet = data.meshlets.size();
+			build_meshlets(data, lod.first_index, lod.indices_number, max_vertices, max_triangles, owners, canonical);
+			lod.meshlets_number = data.meshlets.size() - lod.first_meshlet;
+		}
+	}
+
+	void cull_meshlets(const Object_Data& data, size_t first_meshlet, size_t meshlets_number,
+					   const Math_3d::Frustum& frustum, const Math_3d::Vector_3d& camera_position,
+					   std::vector<Draw_Range>& ranges)
+	{
+		ranges.clear();
+		for (size_t i = first_meshlet; i < first_meshlet + meshlets_number; ++i)
+		{
+			const Meshlet& meshlet = data.meshlets[i];
+			if (!frustum.intersects_sphere(meshlet.center, meshlet.radius))
+			{
+				continue;
+			}
+
+			// Back-facing if camera looks along every normal
+			// from any point of sphere (Kapoulkine, meshoptimizer)
+			const Math_3d::Vector_3d view = meshlet.center - camera_position;
+			const float distance = sqrtf(view & view);
+			if ((view & meshlet.cone_axis) >= meshlet.cone_cutoff * distance + meshlet.radius)
+			{
+				continue;
+			}
+
+			if (!ranges.empty() && ranges.back().first_index + ranges.back().indices_number == meshlet.first_index)
+			{
+				ranges.back().indices_number += meshlet.indices_number;
+			}
+			else
+			{
+				ranges.push_back({ meshlet.first_index, meshlet.indices_number });
+			}
+		}
+	}
+}
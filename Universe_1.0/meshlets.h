@@ -0,0 +1,54 @@
+/******************************************************************************
+	 * File: meshlets.h
+	 * Description: Contains meshlet building and per cluster culling.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "geometry.h"
+#include "math_3d_frustum.h"
+
+namespace Geometry
+{
+	/**
+	* @struct Draw_Range
+	* Indices given to one DrawIndexed
+	*/
+	struct Draw_Range
+	{
+		uint32_t first_index;
+		uint32_t indices_number;
+	};
+
+	/**
+	 * Split indices to meshlets of at most max_vertices unique vertices
+	 * and max_triangles triangles. Triangles keep their order, so
+	 * cache and overdraw optimized meshes give compact clusters and
+	 * every meshlet is a range of index buffer. Levels of detail are
+	 * split separately and get their range of meshlets. Triangles are
+	 * drawn without culling, so levels with open edges get no normal
+	 * cones (cone_cutoff 1).
+	 */
+	void build_meshlets(Object_Data& data, size_t max_vertices = 64, size_t max_triangles = 124);
+
+	/**
+	 * Append to ranges (cleared first) index ranges of meshlets
+	 * [first_meshlet, first_meshlet + meshlets_number) which are
+	 * in frustum and have some triangle facing camera.
+	 * Frustum and camera_position are in object space of data,
+	 * facing is kept by any affine transform, so does not depend
+	 * on data.transform. Neighbour visible meshlets are merged
+	 * to one range.
+	 */
+	void cull_meshlets(const Object_Data& data, size_t first_meshlet, size_t meshlets_number,
+					   const Math_3d::Frustum& frustum, const Math_3d::Vector_3d& camera_position,
+					   std::vector<Draw_Range>& ranges);
+}
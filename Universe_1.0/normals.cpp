@@ -0,0 +1,187 @@
+/******************************************************************************
+	 * File: normals.cpp
+	 * Description: Contains vertex normals generation from triangles.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <stdint.h>
+#include <vector>
+
+#include "normals.h"
+#include "math_3d_batch.h"
+#include "thread_pool.h"
+
+namespace Geometry
+{
+	namespace
+	{
+		// Vertices gathered and normalized at once
+		const size_t normalize_chunk = 256;
+		// Smallest piece of work given to a thread
+		const size_t min_parallel_chunk = 1024;
+
+		/**
+		 * Buffers kept between calls, fresh ones cost
+		 * more in page faults than the whole pass
+		 */
+		struct Scratch
+		{
+			std::vector<Math_3d::Vector_3d> faces;
+			// Per triangle corner for Normal_Weight::edge_length
+			std::vector<float> corner_weights;
+			std::vector<uint32_t> offsets;
+			std::vector<uint32_t> adjacency;
+		};
+		thread_local Scratch scratch;
+
+		template<class Index, bool Edge_Weighted>
+		void compute_normals(const Index* indices, size_t triangles_number, Vertex* vertices,
+							 size_t first_vertex, size_t vertices_number)
+		{
+			Thread_Pool& pool = Thread_Pool::get_instance();
+
+			// Face normals, cross product length is twice the area
+			std::vector<Math_3d::Vector_3d>& faces = scratch.faces;
+			std::vector<float>& corner_weights = scratch.corner_weights;
+			faces.resize(triangles_number);
+			if (Edge_Weighted)
+			{
+				corner_weights.resize(triangles_number * 3);
+			}
+			pool.parallel_for(0, triangles_number, [&](size_t begin, size_t end)
+			{
+				for (size_t triangle = begin; triangle < end; ++triangle)
+				{
+					const Math_3d::Vector_3d& a = vertices[indices[triangle * 3]].pos;
+					const Math_3d::Vector_3d& b = vertices[indices[triangle * 3 + 1]].pos;
+					const Math_3d::Vector_3d& c = vertices[indices[triangle * 3 + 2]].pos;
+					const float ab_x = b.x - a.x, ab_y = b.y - a.y, ab_z = b.z - a.z;
+					const float ac_x = c.x - a.x, ac_y = c.y - a.y, ac_z = c.z - a.z;
+					Math_3d::Vector_3d& face = faces[triangle];
+					face.x = ab_y * ac_z - ab_z * ac_y;
+					face.y = ab_z * ac_x - ab_x * ac_z;
+					face.z = ab_x * ac_y - ab_y * ac_x;
+
+					if (Edge_Weighted)
+					{
+						// 1 / (|e1|^2 * |e2|^2) of edges at each corner
+						const float ab_sq = ab_x * ab_x + ab_y * ab_y + ab_z * ab_z;
+						const float ac_sq = ac_x * ac_x + ac_y * ac_y + ac_z * ac_z;
+						const float bc_x = c.x - b.x, bc_y = c.y - b.y, bc_z = c.z - b.z;
+						const float bc_sq = bc_x * bc_x + bc_y * bc_y + bc_z * bc_z;
+						float* weights = &corner_weights[triangle * 3];
+						weights[0] = ab_sq * ac_sq > 0.0f ? 1.0f / (ab_sq * ac_sq) : 0.0f;
+						weights[1] = ab_sq * bc_sq > 0.0f ? 1.0f / (ab_sq * bc_sq) : 0.0f;
+						weights[2] = ac_sq * bc_sq > 0.0f ? 1.0f / (ac_sq * bc_sq) : 0.0f;
+					}
+				}
+			}, min_parallel_chunk);
+
+			// CSR adjacency: triangle corners of vertex v are
+			// adjacency[offsets[v] .. offsets[v + 1]).
+			// Counts go to v + 2, so filling with offsets[v + 1]
+			// as cursor leaves it at end of v
+			std::vector<uint32_t>& offsets = scratch.offsets;
+			offsets.assign(vertices_number + 2, 0);
+			for (size_t i = 0; i < triangles_number * 3; ++i)
+			{
+				size_t vertex = indices[i];
+				if (vertex >= first_vertex)
+				{
+					++offsets[vertex - first_vertex + 2];
+				}
+			}
+			for (size_t v = 2; v < vertices_number + 2; ++v)
+			{
+				offsets[v] += offsets[v - 1];
+			}
+			std::vector<uint32_t>& adjacency = scratch.adjacency;
+			adjacency.resize(offsets.back());
+			for (size_t i = 0; i < triangles_number * 3; ++i)
+			{
+				size_t vertex = indices[i];
+				if (vertex >= first_vertex)
+				{
+					adjacency[offsets[vertex - first_vertex + 1]++] = static_cast<uint32_t>(i);
+				}
+			}
+
+			// Each vertex writes only itself
+			Vertex* out = vertices + first_vertex;
+			pool.parallel_for(0, vertices_number, [&](size_t begin, size_t end)
+			{
+				Math_3d::Vector_3d sums[normalize_chunk];
+				bool keep[normalize_chunk];
+				for (size_t chunk = begin; chunk < end; chunk += normalize_chunk)
+				{
+					const size_t count = end - chunk < normalize_chunk ? end - chunk : normalize_chunk;
+					for (size_t i = 0; i < count; ++i)
+					{
+						const size_t v = chunk + i;
+						float x = 0.0f, y = 0.0f, z = 0.0f;
+						for (uint32_t j = offsets[v]; j < offsets[v + 1]; ++j)
+						{
+							const uint32_t corner = adjacency[j];
+							const Math_3d::Vector_3d& face = faces[corner / 3];
+							const float weight = Edge_Weighted ? corner_weights[corner] : 1.0f;
+							x += face.x * weight;
+							y += face.y * weight;
+							z += face.z * weight;
+						}
+						// Zero sum would normalize to NaN, old normal is kept
+						keep[i] = x == 0.0f && y == 0.0f && z == 0.0f;
+						sums[i].x = keep[i] ? 1.0f : x;
+						sums[i].y = y;
+						sums[i].z = z;
+					}
+					Math_3d::Batch::normalize(sums, sums, count);
+					for (size_t i = 0; i < count; ++i)
+					{
+						if (!keep[i])
+						{
+							out[chunk + i].normal = sums[i];
+						}
+					}
+				}
+			}, min_parallel_chunk);
+		}
+
+		template<class Index>
+		void compute_normals(const Index* indices, size_t triangles_number, Vertex* vertices,
+							 size_t first_vertex, size_t vertices_number, Normal_Weight weight)
+		{
+			if (weight == Normal_Weight::edge_length)
+			{
+				compute_normals<Index, true>(indices, triangles_number, vertices, first_vertex, vertices_number);
+			}
+			else
+			{
+				compute_normals<Index, false>(indices, triangles_number, vertices, first_vertex, vertices_number);
+			}
+		}
+	}
+
+	void compute_normals(Object_Data& data, size_t first_vertex, size_t first_index, Normal_Weight weight)
+	{
+		if (first_vertex >= data.vertices.size() || first_index >= data.indices.size())
+		{
+			return;
+		}
+		const size_t vertices_number = data.vertices.size() - first_vertex;
+		const size_t triangles_number = (data.indices.size() - first_index) / 3;
+		if (data.indices.is_wide())
+		{
+			compute_normals(data.indices.data_32() + first_index, triangles_number, data.vertices.data(),
+							first_vertex, vertices_number, weight);
+		}
+		else
+		{
+			compute_normals(data.indices.data_16() + first_index, triangles_number, data.vertices.data(),
+							first_vertex, vertices_number, weight);
+		}
+	}
+}
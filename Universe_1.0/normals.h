@@ -0,0 +1,51 @@
+/******************************************************************************
+	 * File: normals.h
+	 * Description: Contains vertex normals generation from triangles.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+
+#include "geometry.h"
+
+namespace Geometry
+{
+	/**
+	 * Weight of face normal in vertex normal
+	 */
+	enum class Normal_Weight
+	{
+		/**
+		 * Face area, cheapest
+		 */
+		area,
+		/**
+		 * Face area over squared lengths of both edges at vertex,
+		 * i.e. sin(angle) / (|e1| * |e2|) (Max, 1999). Exact on spheres
+		 * and does not depend on how rectangles are split to triangles,
+		 * so corners of coarse quad meshes stay symmetric.
+		 */
+		edge_length
+	};
+
+	/**
+	 * Smooth normals of vertices[first_vertex ..) from triangles
+	 * indices[first_index ..): sum of adjacent face normals weighted
+	 * by weight, normalized. Works for any mesh with consistent
+	 * winding, normal looks where triangle is counter-clockwise
+	 * in right-handed coordinates. Vertices of no triangle or of
+	 * zero area ones only keep their normal.
+	 *
+	 * Runs on Thread_Pool without atomics: face normals are computed
+	 * per triangle, then each vertex gathers faces through CSR
+	 * vertex -> triangle corners adjacency and normalizes with
+	 * Math_3d::Batch.
+	 */
+	void compute_normals(Object_Data& data, size_t first_vertex = 0, size_t first_index = 0,
+						 Normal_Weight weight = Normal_Weight::area);
+}
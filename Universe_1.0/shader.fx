@@ -10,7 +10,6 @@
 //--------------------------------------------------------------------------------------
 cbuffer ConstantBuffer //: register( b0 )
 {
-	matrix World;
 	matrix View;
 	matrix Projection;
     float4 light_color;
@@ -22,7 +21,13 @@ cbuffer ConstantBuffer //: register( b0 )
 
 cbuffer ConstantBuffer //: register(b1)
 {
+	// Object placement, normals use inverse transpose
+	matrix World;
+	matrix WorldNormal;
 	float4 color;
+	// Compact vertices: pos = bounds_offset + bounds_scale * stored pos
+	float4 bounds_offset;
+	float4 bounds_scale;
 	//float4 plane_num; //num, curr_obj, tmp_1, tmp_2
 }
 
@@ -108,7 +113,7 @@ VS_OUTPUT VS( float4 Pos : POSITION, float4 Normal: NORMAL)
 
     // Vars for diffuse color calc
     float3 point_pos = mul(Pos, World).xyz;
-    float3 normal = normalize(Normal.xyz);
+    float3 normal = normalize(mul(Normal.xyz, (float3x3)WorldNormal));
     float3 light_vec = normalize(light_pos.xyz - point_pos.xyz);
 
     // Calc color
@@ -124,6 +129,28 @@ VS_OUTPUT VS( float4 Pos : POSITION, float4 Normal: NORMAL)
 }
 
 
+//--------------------------------------------------------------------------------------
+// Vertex Shader for Compact_Vertex
+// Pos is half float or unorm16 relative to object bounds,
+// Normal is octahedral snorm16
+//--------------------------------------------------------------------------------------
+float3 decode_octahedral(float2 value)
+{
+    float3 normal = float3(value.xy, 1.0f - abs(value.x) - abs(value.y));
+    if (normal.z < 0.0f)
+    {
+        normal.xy = (1.0f - abs(value.yx)) * (value.xy >= 0.0f ? 1.0f : -1.0f);
+    }
+    return normalize(normal);
+}
+
+VS_OUTPUT VS_Compact( float4 Pos : POSITION, float2 Normal : NORMAL )
+{
+    float4 pos = float4(bounds_offset.xyz + bounds_scale.xyz * Pos.xyz, 1.0f);
+    return VS(pos, float4(decode_octahedral(Normal), 0.0f));
+}
+
+
 //--------------------------------------------------------------------------------------
 // Pixel Shader
 //--------------------------------------------------------------------------------------
@@ -0,0 +1,425 @@
+/******************************************************************************
+	 * File: simplifier.cpp
+	 * Description: Contains quadric error mesh simplification.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+#include "simplifier.h"
+#include "mesh_cleanup.h"
+#include "thread_pool.h"
+
+namespace Geometry
+{
+	namespace
+	{
+		const uint32_t no_vertex = 0xFFFFFFFFu;
+		// Smallest piece of work given to a thread
+		const size_t min_parallel_chunk = 4096;
+
+		/**
+		 * Weighted sum of squared distances to planes: p A p + 2 b p + c,
+		 * A is symmetric, doubles keep c - b A^-1 b from cancelling
+		 */
+		struct Quadric
+		{
+			double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+			double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+			double c = 0.0;
+			double weight = 0.0;
+
+			void add(const Quadric& quadric)
+			{
+				a00 += quadric.a00; a01 += quadric.a01; a02 += quadric.a02;
+				a11 += quadric.a11; a12 += quadric.a12; a22 += quadric.a22;
+				b0 += quadric.b0; b1 += quadric.b1; b2 += quadric.b2;
+				c += quadric.c;
+				weight += quadric.weight;
+			}
+
+			/**
+			 * Plane through point with unit normal, weighted
+			 */
+			void add_plane(double x, double y, double z, const Math_3d::Vector_3d& point, double weight)
+			{
+				const double d = -(x * point.x + y * point.y + z * point.z);
+				a00 += weight * x * x; a01 += weight * x * y; a02 += weight * x * z;
+				a11 += weight * y * y; a12 += weight * y * z; a22 += weight * z * z;
+				b0 += weight * x * d; b1 += weight * y * d; b2 += weight * z * d;
+				c += weight * d * d;
+				this->weight += weight;
+			}
+
+			/**
+			 * Weighted mean of squared distances, so it is squared
+			 * length whatever the weights
+			 */
+			double get_error(const Math_3d::Vector_3d& point) const
+			{
+				if (weight <= 0.0)
+				{
+					return 0.0;
+				}
+				const double x = point.x, y = point.y, z = point.z;
+				const double error = a00 * x * x + a11 * y * y + a22 * z * z +
+									 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+									 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+				// Rounding makes error of points on planes slightly negative
+				return error > 0.0 ? error / weight : 0.0;
+			}
+		};
+
+		struct Collapse
+		{
+			float cost;
+			uint32_t from;
+			uint32_t to;
+		};
+
+		/**
+		 * CSR vertex -> triangles: adjacency[offsets[v] .. offsets[v + 1])
+		 */
+		void build_adjacency(const std::vector<uint32_t>& indices, size_t vertices_number,
+							 std::vector<uint32_t>& offsets, std::vector<uint32_t>& adjacency)
+		{
+			offsets.assign(vertices_number + 2, 0);
+			for (uint32_t vertex : indices)
+			{
+				++offsets[vertex + 2];
+			}
+			for (size_t v = 2; v < vertices_number + 2; ++v)
+			{
+				offsets[v] += offsets[v - 1];
+			}
+			adjacency.resize(indices.size());
+			for (size_t i = 0; i < indices.size(); ++i)
+			{
+				adjacency[offsets[indices[i] + 1]++] = static_cast<uint32_t>(i / 3);
+			}
+			offsets.pop_back();
+		}
+
+		/**
+		 * Vertices of edges without exactly one opposite edge
+		 */
+		std::vector<bool> find_locked(const std::vector<uint32_t>& indices, size_t vertices_number,
+									  const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& adjacency)
+		{
+			std::vector<bool> locked(vertices_number, false);
+			for (size_t i = 0; i < indices.size(); ++i)
+			{
+				const uint32_t a = indices[i];
+				const uint32_t b = indices[i - i % 3 + (i + 1) % 3];
+				// Opposite edge is in triangle of both, fan centers have thousands
+				const uint32_t fewer = offsets[a + 1] - offsets[a] < offsets[b + 1] - offsets[b] ? a : b;
+				int opposite = 0;
+				for (uint32_t j = offsets[fewer]; j < offsets[fewer + 1]; ++j)
+				{
+					const uint32_t* corners = &indices[adjacency[j] * 3];
+					for (int k = 0; k < 3; ++k)
+					{
+						opposite += corners[k] == b && corners[(k + 1) % 3] == a ? 1 : 0;
+					}
+				}
+				if (opposite != 1)
+				{
+					locked[a] = true;
+					locked[b] = true;
+				}
+			}
+			return locked;
+		}
+
+		/**
+		 * Triangles of from turn over or vanish if it moves to to,
+		 * corners collapsed earlier in this pass are taken through remap
+		 */
+		bool flips(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap, const Vertex* vertices,
+				   uint32_t from, uint32_t to, const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& adjacency)
+		{
+			const Math_3d::Vector_3d& target = vertices[to].pos;
+			for (uint32_t j = offsets[from]; j < offsets[from + 1]; ++j)
+			{
+				const uint32_t* triangle = &indices[adjacency[j] * 3];
+				const uint32_t corners[3] = { remap[triangle[0]], remap[triangle[1]], remap[triangle[2]] };
+				if (corners[0] == to || corners[1] == to || corners[2] == to ||
+					corners[0] == corners[1] || corners[1] == corners[2] || corners[0] == corners[2])
+				{
+					continue;
+				}
+				// Rotate triangle so from is first
+				const int k = corners[0] == from ? 0 : (corners[1] == from ? 1 : 2);
+				const Math_3d::Vector_3d& b = vertices[corners[(k + 1) % 3]].pos;
+				const Math_3d::Vector_3d& c = vertices[corners[(k + 2) % 3]].pos;
+				const Math_3d::Vector_3d& a = vertices[from].pos;
+				// Raw floats, this runs for every collapse tried
+				const float ab_x = b.x - a.x, ab_y = b.y - a.y, ab_z = b.z - a.z;
+				const float ac_x = c.x - a.x, ac_y = c.y - a.y, ac_z = c.z - a.z;
+				const float tb_x = b.x - target.x, tb_y = b.y - target.y, tb_z = b.z - target.z;
+				const float tc_x = c.x - target.x, tc_y = c.y - target.y, tc_z = c.z - target.z;
+				const float before_x = ab_y * ac_z - ab_z * ac_y;
+				const float before_y = ab_z * ac_x - ab_x * ac_z;
+				const float before_z = ab_x * ac_y - ab_y * ac_x;
+				const float after_x = tb_y * tc_z - tb_z * tc_y;
+				const float after_y = tb_z * tc_x - tb_x * tc_z;
+				const float after_z = tb_x * tc_y - tb_y * tc_x;
+				if (before_x * after_x + before_y * after_y + before_z * after_z <= 0.0f)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * Counting sort by top 16 bits of cost: non-negative floats
+		 * order as their bits, 8 bits of mantissa are plenty for
+		 * order of collapses and one pass is much cheaper than std::sort
+		 */
+		void sort_collapses(const std::vector<Collapse>& collapses, std::vector<Collapse>& sorted)
+		{
+			const size_t buckets_number = 1 << 16;
+			auto get_bucket = [](float cost) -> uint32_t
+			{
+				uint32_t bits;
+				memcpy(&bits, &cost, sizeof(bits));
+				return bits >> 15;
+			};
+
+			std::vector<uint32_t> offsets(buckets_number + 1, 0);
+			for (const Collapse& collapse : collapses)
+			{
+				++offsets[get_bucket(collapse.cost) + 1];
+			}
+			for (size_t bucket = 1; bucket <= buckets_number; ++bucket)
+			{
+				offsets[bucket] += offsets[bucket - 1];
+			}
+			sorted.resize(collapses.size());
+			for (const Collapse& collapse : collapses)
+			{
+				sorted[offsets[get_bucket(collapse.cost)]++] = collapse;
+			}
+		}
+
+		std::unique_ptr<Object_Data> copy_mesh(const Object_Data& data)
+		{
+			std::unique_ptr<Object_Data> copy = std::make_unique<Object_Data>();
+			copy->vertices.assign(data.vertices.begin(), data.vertices.end());
+			copy->indices.set_vertex_count(data.vertices.size());
+			copy->indices.resize(data.indices.size());
+			for (size_t i = 0; i < data.indices.size(); ++i)
+			{
+				copy->indices.set(i, data.indices[i]);
+			}
+			copy->size = data.size;
+			copy->color = data.color;
+			copy->format = data.format;
+			copy->transform = data.transform;
+			return copy;
+		}
+	}
+
+	float simplify_mesh(Object_Data& data, const Simplify_Options& options)
+	{
+		const size_t vertices_number = data.vertices.size();
+		const Vertex* vertices = data.vertices.data();
+		std::vector<uint32_t> indices(data.indices.size() - data.indices.size() % 3);
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			indices[i] = data.indices[i];
+		}
+		if (indices.empty() || indices.size() / 3 <= options.target_triangles)
+		{
+			return 0.0f;
+		}
+
+		// Errors are relative to largest side of box
+		Math_3d::Vector_3d low = vertices[indices[0]].pos;
+		Math_3d::Vector_3d high = low;
+		for (uint32_t vertex : indices)
+		{
+			const Math_3d::Vector_3d& pos = vertices[vertex].pos;
+			low = Math_3d::Vector_3d(fminf(low.x, pos.x), fminf(low.y, pos.y), fminf(low.z, pos.z));
+			high = Math_3d::Vector_3d(fmaxf(high.x, pos.x), fmaxf(high.y, pos.y), fmaxf(high.z, pos.z));
+		}
+		const float extent = fmaxf(fmaxf(high.x - low.x, high.y - low.y), fmaxf(high.z - low.z, 1e-20f));
+		const float max_error = options.target_error * extent;
+		const float max_cost = max_error * max_error;
+
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> adjacency;
+		build_adjacency(indices, vertices_number, offsets, adjacency);
+		const std::vector<bool> locked = find_locked(indices, vertices_number, offsets, adjacency);
+
+		// Area weighted plane quadrics, larger triangles count more
+		// in mean distance but cost stays squared distance
+		std::vector<Quadric> quadrics(vertices_number);
+		for (size_t triangle = 0; triangle < indices.size() / 3; ++triangle)
+		{
+			const Math_3d::Vector_3d& a = vertices[indices[triangle * 3]].pos;
+			const Math_3d::Vector_3d& b = vertices[indices[triangle * 3 + 1]].pos;
+			const Math_3d::Vector_3d& c = vertices[indices[triangle * 3 + 2]].pos;
+			const Math_3d::Vector_3d cross = (b - a) ^ (c - a);
+			const double length = sqrt(static_cast<double>(cross & cross));
+			if (length == 0.0)
+			{
+				continue;
+			}
+			Quadric plane;
+			plane.add_plane(cross.x / length, cross.y / length, cross.z / length, a, 0.5 * length);
+			for (int k = 0; k < 3; ++k)
+			{
+				quadrics[indices[triangle * 3 + k]].add(plane);
+			}
+		}
+
+		std::vector<uint32_t> remap(vertices_number);
+		for (size_t v = 0; v < vertices_number; ++v)
+		{
+			remap[v] = static_cast<uint32_t>(v);
+		}
+		std::vector<Collapse> collapses;
+		std::vector<Collapse> sorted;
+		std::vector<bool> moved;
+		float result_cost = 0.0f;
+		size_t triangles_number = indices.size() / 3;
+
+		while (triangles_number > options.target_triangles)
+		{
+			// Cheaper direction of each triangle edge, shared edges are
+			// taken once: edges of unlocked vertices always have opposite
+			collapses.resize(indices.size());
+			Thread_Pool::get_instance().parallel_for(0, indices.size(), [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					const uint32_t a = indices[i];
+					const uint32_t b = indices[i - i % 3 + (i + 1) % 3];
+					Collapse& collapse = collapses[i];
+					collapse.from = no_vertex;
+					if (a > b || (locked[a] && locked[b]))
+					{
+						continue;
+					}
+					Quadric quadric = quadrics[a];
+					quadric.add(quadrics[b]);
+					const float cost_to_b = locked[a] ? FLT_MAX : static_cast<float>(quadric.get_error(vertices[b].pos));
+					const float cost_to_a = locked[b] ? FLT_MAX : static_cast<float>(quadric.get_error(vertices[a].pos));
+					collapse.from = cost_to_b <= cost_to_a ? a : b;
+					collapse.to = cost_to_b <= cost_to_a ? b : a;
+					collapse.cost = cost_to_b <= cost_to_a ? cost_to_b : cost_to_a;
+				}
+			}, min_parallel_chunk);
+			collapses.erase(std::remove_if(collapses.begin(), collapses.end(), [max_cost](const Collapse& collapse)
+			{
+				return collapse.from == no_vertex || collapse.cost > max_cost;
+			}), collapses.end());
+			sort_collapses(collapses, sorted);
+
+			// Vertex moves or takes collapse once per pass, so remap is one step
+			moved.assign(vertices_number, false);
+			size_t collapsed = 0;
+			for (const Collapse& collapse : sorted)
+			{
+				if (triangles_number <= options.target_triangles)
+				{
+					break;
+				}
+				if (moved[collapse.from] || moved[collapse.to] ||
+					flips(indices, remap, vertices, collapse.from, collapse.to, offsets, adjacency))
+				{
+					continue;
+				}
+
+				// Triangles of edge vanish unless already gone
+				for (uint32_t j = offsets[collapse.from]; j < offsets[collapse.from + 1]; ++j)
+				{
+					const uint32_t* triangle = &indices[adjacency[j] * 3];
+					const uint32_t a = remap[triangle[0]], b = remap[triangle[1]], c = remap[triangle[2]];
+					if (a != b && b != c && a != c && (a == collapse.to || b == collapse.to || c == collapse.to))
+					{
+						--triangles_number;
+					}
+				}
+				moved[collapse.from] = true;
+				moved[collapse.to] = true;
+				remap[collapse.from] = collapse.to;
+				quadrics[collapse.to].add(quadrics[collapse.from]);
+				result_cost = fmaxf(result_cost, collapse.cost);
+				++collapsed;
+			}
+			if (collapsed == 0)
+			{
+				break;
+			}
+
+			// Triangles of collapsed edges lose a vertex
+			size_t kept = 0;
+			for (size_t triangle = 0; triangle < indices.size() / 3; ++triangle)
+			{
+				const uint32_t a = remap[indices[triangle * 3]];
+				const uint32_t b = remap[indices[triangle * 3 + 1]];
+				const uint32_t c = remap[indices[triangle * 3 + 2]];
+				if (a == b || b == c || a == c)
+				{
+					continue;
+				}
+				indices[kept * 3] = a;
+				indices[kept * 3 + 1] = b;
+				indices[kept * 3 + 2] = c;
+				++kept;
+			}
+			indices.resize(kept * 3);
+			triangles_number = kept;
+			build_adjacency(indices, vertices_number, offsets, adjacency);
+		}
+
+		data.indices.resize(indices.size());
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			data.indices.set(i, indices[i]);
+		}
+		data.size = static_cast<int>(indices.size());
+		clean_mesh(data);
+		data.update_bounds();
+		return sqrtf(result_cost) / extent;
+	}
+
+	std::future<std::unique_ptr<Object_Data>> simplify_mesh_async(const Object_Data& data, const Simplify_Options& options)
+	{
+		struct Task
+		{
+			std::promise<std::unique_ptr<Object_Data>> promise;
+			std::unique_ptr<Object_Data> mesh;
+		};
+		std::shared_ptr<Task> task = std::make_shared<Task>();
+		task->mesh = copy_mesh(data);
+		std::future<std::unique_ptr<Object_Data>> result = task->promise.get_future();
+
+		Thread_Pool::get_instance().push([task, options]()
+		{
+			try
+			{
+				simplify_mesh(*task->mesh, options);
+				task->promise.set_value(std::move(task->mesh));
+			}
+			catch (...)
+			{
+				task->promise.set_exception(std::current_exception());
+			}
+		});
+		return result;
+	}
+}
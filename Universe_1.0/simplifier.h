@@ -0,0 +1,60 @@
+/******************************************************************************
+	 * File: simplifier.h
+	 * Description: Contains quadric error mesh simplification.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <future>
+#include <memory>
+
+#include "geometry.h"
+
+namespace Geometry
+{
+	/**
+	* @struct Simplify_Options
+	* Simplification stops at whichever target comes first
+	*/
+	struct Simplify_Options
+	{
+		size_t target_triangles = 0;
+		/**
+		 * Largest error of collapse: root of area weighted mean
+		 * squared distance from kept vertex to planes of triangles
+		 * merged into it, fraction of largest side of mesh box.
+		 * Same for any scale of mesh.
+		 */
+		float target_error = 0.01f;
+	};
+
+	/**
+	 * Edge collapse simplification (Garland, Heckbert, 1997).
+	 * Every vertex has quadric of area weighted planes of its triangles,
+	 * edge collapses into one of its vertices, so vertex data stays valid,
+	 * cost is error of both quadrics at that vertex over their total area,
+	 * so it is squared distance whatever the scale of mesh.
+	 * Collapses go in passes: costs of all edges are computed in parallel
+	 * and sorted, cheapest ones are applied while they touch no vertex
+	 * moved in this pass and flip no triangle.
+	 * Vertices of open or non-manifold edges never move, so borders
+	 * and seams of vertices split by normal keep their shape.
+	 * Unused vertices are removed with clean_mesh, which also clears
+	 * levels of detail and meshlets: simplify before make_lods
+	 * and build_meshlets.
+	 * Returns error reached, same units as target_error.
+	 */
+	float simplify_mesh(Object_Data& data, const Simplify_Options& options);
+
+	/**
+	 * simplify_mesh of copy of data on Thread_Pool, data
+	 * can be changed or destroyed once call returns.
+	 * Result buffers are on heap.
+	 */
+	std::future<std::unique_ptr<Object_Data>> simplify_mesh_async(const Object_Data& data, const Simplify_Options& options);
+}
@@ -0,0 +1,275 @@
+/******************************************************************************
+	 * File: static_generator.h
+	 * Description: Contains generator specialized for fixed shape and tessellation.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+#include <memory>
+
+#include "geometry.h"
+#include "math_3d_expr.h"
+#include "thread_pool.h"
+
+namespace Geometry
+{
+	/**
+	* @class Static_Generator
+	* Generator of tube with regular Sides-gon profile, Slices rings
+	* evenly spaced in t and caps split by Split_Points (no caps if < 0).
+	* Everything Generator decides at runtime is a template parameter:
+	* profile cos / sin are built at compile time, ring loops have
+	* fixed trip count, buffers are sized once, indices are written
+	* straight into 16 or 32 bit storage.
+	* Normals of rings are radial, which is what Generator averages
+	* to for a regular profile. Output matches Generator with
+	* Shape::circle(Sides, radius), Slices fixed slices and
+	* Cap::subdivided otherwise.
+	*/
+	template<int Sides, int Slices, int Split_Points = 3>
+	class Static_Generator
+	{
+		static_assert(Sides >= 3, "Profile needs at least 3 sides");
+		static_assert(Slices >= 2, "Tube needs at least 2 slices");
+
+		static const bool solid = Split_Points >= 0;
+		// Vertex rows of cap sector: Split_Points + 2, ..., 1
+		static const int rows = Split_Points + 2;
+		static const size_t sector_vertices = solid ? rows * (rows + 1) / 2 : 0;
+		static const size_t sector_indices = solid ? (Split_Points + 1) * (Split_Points + 1) * 3 : 0;
+		static const size_t ring_indices = Sides * 6;
+
+		std::unique_ptr<Path> path;
+		float radius;
+		Math_3d::Vector_3d base_vec;
+
+		template<class Index>
+		static void make_ring_indices(Index* indices, uint32_t first_vertex);
+		template<class Index>
+		static void make_cap_indices(Index* indices, uint32_t first_vertex);
+		template<class Index>
+		static void make_indices(Index* indices, uint32_t first_vertex);
+
+		static void make_cap(Vertex* vertices, const Vertex* ring, Math_3d::Vector_3d center, Math_3d::Vector_3d normal);
+
+	public:
+		static const size_t vertices_number = Slices * Sides + (solid ? 2 + 2 * Sides * sector_vertices : 0);
+		static const size_t indices_number = (Slices - 1) * ring_indices + (solid ? 2 * Sides * sector_indices : 0);
+
+		Static_Generator(std::unique_ptr<Path> path, float radius, Math_3d::Vector_3d base_vec)
+		: path(std::move(path)), radius(radius), base_vec(base_vec) {};
+
+		static Mesh_Size plan_mesh()
+		{
+			Mesh_Size size;
+			size.vertices = vertices_number;
+			size.indices = indices_number;
+			return size;
+		}
+
+		void make_mesh(Object_Data& data);
+	};
+
+	/**
+	 * Fast paths of common profiles
+	 */
+	template<int Slices, int Split_Points = 3>
+	using Quad_Generator = Static_Generator<4, Slices, Split_Points>;
+	template<int Slices, int Split_Points = 3>
+	using Hexagon_Generator = Static_Generator<6, Slices, Split_Points>;
+	template<int Slices, int Split_Points = 3>
+	using Hexadecagon_Generator = Static_Generator<16, Slices, Split_Points>;
+
+
+	template<int Sides, int Slices, int Split_Points>
+	template<class Index>
+	void Static_Generator<Sides, Slices, Split_Points>::make_ring_indices(Index* indices, uint32_t first_vertex)
+	{
+		// Quads between ring at first_vertex and next one
+		for (int i = 0; i < Sides; ++i)
+		{
+			Index p1_index = static_cast<Index>(first_vertex + i);
+			Index p2_index = static_cast<Index>(first_vertex + (i + 1) % Sides);
+			Index p3_index = static_cast<Index>(first_vertex + Sides + (i + 1) % Sides);
+			Index p4_index = static_cast<Index>(first_vertex + Sides + i);
+
+			indices[0] = p1_index;
+			indices[1] = p2_index;
+			indices[2] = p3_index;
+			indices[3] = p1_index;
+			indices[4] = p3_index;
+			indices[5] = p4_index;
+			indices += 6;
+		}
+	}
+
+	template<int Sides, int Slices, int Split_Points>
+	template<class Index>
+	void Static_Generator<Sides, Slices, Split_Points>::make_cap_indices(Index* indices, uint32_t first_vertex)
+	{
+		// Triangles of sector rows, same order as Generator
+		for (int i = 0; i < Sides; ++i)
+		{
+			uint32_t row_start = first_vertex + static_cast<uint32_t>(i * sector_vertices);
+			for (int j = 0; j < Split_Points + 1; ++j)
+			{
+				const uint32_t row_size = rows - j;
+				for (int k = 0; k < Split_Points * 2 + 1 - j * 2; ++k)
+				{
+					uint32_t low = row_start + (k / 2);
+					if (!(k % 2))
+					{
+						indices[0] = static_cast<Index>(low);
+						indices[1] = static_cast<Index>(low + 1);
+						indices[2] = static_cast<Index>(low + row_size);
+					}
+					else
+					{
+						indices[0] = static_cast<Index>(low + 1);
+						indices[1] = static_cast<Index>(low + row_size);
+						indices[2] = static_cast<Index>(low + row_size + 1);
+					}
+					indices += 3;
+				}
+				row_start += row_size;
+			}
+		}
+	}
+
+	template<int Sides, int Slices, int Split_Points>
+	template<class Index>
+	void Static_Generator<Sides, Slices, Split_Points>::make_indices(Index* indices, uint32_t first_vertex)
+	{
+		for (int slice = 1; slice < Slices; ++slice)
+		{
+			make_ring_indices(indices + (slice - 1) * ring_indices, first_vertex + (slice - 1) * Sides);
+		}
+		if (solid)
+		{
+			indices += (Slices - 1) * ring_indices;
+			const uint32_t caps_first_vertex = first_vertex + Slices * Sides + 2;
+			make_cap_indices(indices, caps_first_vertex);
+			make_cap_indices(indices + Sides * sector_indices, caps_first_vertex + Sides * sector_vertices);
+		}
+	}
+
+	template<int Sides, int Slices, int Split_Points>
+	void Static_Generator<Sides, Slices, Split_Points>::make_cap(Vertex* vertices, const Vertex* ring,
+																 Math_3d::Vector_3d center, Math_3d::Vector_3d normal)
+	{
+		const float sector_step = 1.0f / static_cast<float>(Split_Points + 1);
+		for (int i = 0; i < Sides; ++i)
+		{
+			const Math_3d::Vector_3d a = ring[i].pos;
+			const Math_3d::Vector_3d ab_vec = ring[(i + 1) % Sides].pos - a;
+			const Math_3d::Vector_3d ac_vec = center - a;
+
+			// A * * B
+			//  * * *
+			//   * *
+			//    C
+			for (int j = 0; j < rows; ++j)
+			{
+				Math_3d::Vector_3d start_point = a + ac_vec * sector_step * static_cast<float>(j);
+				for (int k = 0; k < rows - j; ++k)
+				{
+					vertices->pos = start_point + ab_vec * sector_step * static_cast<float>(k);
+					vertices->normal = normal;
+					++vertices;
+				}
+			}
+		}
+	}
+
+	template<int Sides, int Slices, int Split_Points>
+	void Static_Generator<Sides, Slices, Split_Points>::make_mesh(Object_Data& data)
+	{
+		static constexpr Math_3d::Expr::Unit_Circle<Sides> unit_circle;
+		const float path_delta = 0.01f;
+
+		const size_t first_vertex = data.vertices.size();
+		const size_t first_index = data.indices.size();
+		data.vertices.resize(first_vertex + vertices_number);
+		data.indices.set_vertex_count(first_vertex + vertices_number);
+		data.indices.resize(first_index + indices_number);
+
+		// Evaluate whole path at once
+		std::array<Math_3d::Vector_3d, Slices> centers;
+		std::array<Math_3d::Vector_3d, Slices> tangents;
+		path->sample(0.0f, 1.0f, Slices, centers.data());
+		path->sample_tangents(0.0f, 1.0f, Slices, tangents.data());
+		for (int slice = 0; slice < Slices; ++slice)
+		{
+			// Tangent vanishes where control points repeat, use chord then
+			if ((tangents[slice] & tangents[slice]) == 0.0f)
+			{
+				float t = static_cast<float>(slice) / static_cast<float>(Slices - 1);
+				tangents[slice] = path->get_point(t + path_delta) - path->get_point(t - path_delta);
+			}
+			tangents[slice].normalize();
+		}
+
+		// Rotation minimizing frames turned to start at base_vec
+		const Frame_Table& frame_table = path->get_frames();
+		const Frame first_frame = frame_table.get_frame(0.0f, centers[0], tangents[0]);
+		Math_3d::Vector_3d start_vec = Math_3d::project_vector_to_plane(base_vec, centers[0], first_frame.tangent);
+		float cos_angle = 1.0f;
+		float sin_angle = 0.0f;
+		if ((start_vec & start_vec) > 0.0f)
+		{
+			start_vec = Math_3d::normalized<Precision>(start_vec);
+			cos_angle = start_vec & first_frame.normal;
+			sin_angle = start_vec & first_frame.binormal;
+		}
+
+		Vertex* vertices = &data.vertices[first_vertex];
+		Thread_Pool::get_instance().parallel_for(0, Slices, [&](size_t slice_begin, size_t slice_end)
+		{
+			for (size_t slice = slice_begin; slice < slice_end; ++slice)
+			{
+				float t = static_cast<float>(slice) / static_cast<float>(Slices - 1);
+				const Math_3d::Vector_3d center = centers[slice];
+				const Math_3d::Vector_3d path_vec = tangents[slice];
+				const Math_3d::Vector_3d slice_base_vec = frame_table.get_frame(t, center, path_vec).get_normal(cos_angle, sin_angle);
+				const Math_3d::Vector_3d slice_side_vec = path_vec ^ slice_base_vec;
+
+				Vertex* ring = vertices + slice * Sides;
+				for (int i = 0; i < Sides; ++i)
+				{
+					Math_3d::Vector_3d direction = slice_base_vec * unit_circle.cos_value[i] + slice_side_vec * unit_circle.sin_value[i];
+					ring[i].pos = center + direction * radius;
+					ring[i].normal = direction;
+				}
+			}
+		});
+
+		if (solid)
+		{
+			Vertex* center_vertices = vertices + Slices * Sides;
+			center_vertices[0].pos = path->get_point(0.0f);
+			center_vertices[1].pos = path->get_point(1.0f);
+
+			Vertex* caps = center_vertices + 2;
+			make_cap(caps, vertices, center_vertices[0].pos, tangents[0] * -1.0f);
+			make_cap(caps + Sides * sector_vertices, vertices + (Slices - 1) * Sides, center_vertices[1].pos, tangents[Slices - 1]);
+		}
+
+		if (data.indices.is_wide())
+		{
+			make_indices(data.indices.data_32() + first_index, static_cast<uint32_t>(first_vertex));
+		}
+		else
+		{
+			make_indices(data.indices.data_16() + first_index, static_cast<uint32_t>(first_vertex));
+		}
+		data.size = data.indices.size();
+		data.update_bounds();
+	}
+}
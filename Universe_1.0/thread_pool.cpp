@@ -0,0 +1,179 @@
+/******************************************************************************
+	 * File: thread_pool.cpp
+	 * Description: Contains worker threads pool.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <atomic>
+#include <exception>
+#include <memory>
+
+#include "thread_pool.h"
+
+namespace
+{
+	/**
+	 * State of single parallel_for, shared with helper tasks
+	 * which may start after the loop is already finished
+	 */
+	struct Loop_State
+	{
+		const std::function<void(size_t, size_t)>* body = nullptr;
+		size_t begin = 0;
+		size_t end = 0;
+		size_t chunk = 1;
+		size_t chunks = 0;
+
+		std::atomic<size_t> next_chunk{ 0 };
+		std::atomic<size_t> done_chunks{ 0 };
+
+		std::mutex done_mutex;
+		std::condition_variable done_condition;
+		std::exception_ptr error;
+
+		/**
+		 * Take chunks until none left
+		 */
+		void run()
+		{
+			for (size_t i = next_chunk++; i < chunks; i = next_chunk++)
+			{
+				size_t chunk_begin = begin + i * chunk;
+				size_t chunk_end = chunk_begin + chunk < end ? chunk_begin + chunk : end;
+				try
+				{
+					(*body)(chunk_begin, chunk_end);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(done_mutex);
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+				}
+				if (++done_chunks == chunks)
+				{
+					std::lock_guard<std::mutex> lock(done_mutex);
+					done_condition.notify_all();
+				}
+			}
+		}
+	};
+}
+
+Thread_Pool::Thread_Pool(size_t threads)
+{
+	if (threads == 0)
+	{
+		size_t hardware_threads = std::thread::hardware_concurrency();
+		threads = hardware_threads > 1 ? hardware_threads - 1 : 1;
+	}
+	workers.reserve(threads);
+	for (size_t i = 0; i < threads; ++i)
+	{
+		workers.emplace_back(&Thread_Pool::work, this);
+	}
+}
+
+Thread_Pool::~Thread_Pool()
+{
+	{
+		std::lock_guard<std::mutex> lock(tasks_mutex);
+		stop = true;
+	}
+	tasks_condition.notify_all();
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+Thread_Pool& Thread_Pool::get_instance()
+{
+	static Thread_Pool instance;
+	return instance;
+}
+
+size_t Thread_Pool::size() const
+{
+	return workers.size();
+}
+
+void Thread_Pool::push(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(tasks_mutex);
+		tasks.push(std::move(task));
+	}
+	tasks_condition.notify_one();
+}
+
+void Thread_Pool::work()
+{
+	for (;;)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(tasks_mutex);
+			tasks_condition.wait(lock, [this] { return stop || !tasks.empty(); });
+			if (stop && tasks.empty())
+			{
+				return;
+			}
+			task = std::move(tasks.front());
+			tasks.pop();
+		}
+		task();
+	}
+}
+
+void Thread_Pool::parallel_for(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t min_chunk)
+{
+	if (end <= begin)
+	{
+		return;
+	}
+	const size_t count = end - begin;
+	if (min_chunk == 0)
+	{
+		min_chunk = 1;
+	}
+
+	// Few chunks per thread to balance uneven work
+	size_t chunks = (workers.size() + 1) * 4;
+	if (chunks > count / min_chunk)
+	{
+		chunks = count / min_chunk > 0 ? count / min_chunk : 1;
+	}
+	if (chunks == 1 || workers.empty())
+	{
+		body(begin, end);
+		return;
+	}
+
+	auto state = std::make_shared<Loop_State>();
+	state->body = &body;
+	state->begin = begin;
+	state->end = end;
+	state->chunk = (count + chunks - 1) / chunks;
+	state->chunks = (count + state->chunk - 1) / state->chunk;
+
+	size_t helpers = state->chunks - 1 < workers.size() ? state->chunks - 1 : workers.size();
+	for (size_t i = 0; i < helpers; ++i)
+	{
+		push([state] { state->run(); });
+	}
+	state->run();
+
+	std::unique_lock<std::mutex> lock(state->done_mutex);
+	state->done_condition.wait(lock, [&state] { return state->done_chunks == state->chunks; });
+	if (state->error)
+	{
+		std::rethrow_exception(state->error);
+	}
+}
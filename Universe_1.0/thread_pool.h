@@ -0,0 +1,61 @@
+/******************************************************************************
+	 * File: thread_pool.h
+	 * Description: Contains worker threads pool.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+* @class Thread_Pool
+* Fixed set of worker threads which run queued tasks.
+*/
+class Thread_Pool
+{
+	std::vector<std::thread> workers;
+	std::queue<std::function<void()>> tasks;
+
+	std::mutex tasks_mutex;
+	std::condition_variable tasks_condition;
+	bool stop = false;
+
+	void work();
+
+public:
+	/**
+	 * 0 threads means one per hardware thread except the caller's
+	 */
+	explicit Thread_Pool(size_t threads = 0);
+	~Thread_Pool();
+
+	Thread_Pool(const Thread_Pool&) = delete;
+	Thread_Pool& operator=(const Thread_Pool&) = delete;
+
+	/**
+	 * Pool shared by the engine
+	 */
+	static Thread_Pool& get_instance();
+
+	size_t size() const;
+
+	void push(std::function<void()> task);
+
+	/**
+	 * Call body(chunk_begin, chunk_end) over [begin, end) split into
+	 * chunks of at least min_chunk items, return when all are done.
+	 * Caller thread takes chunks too, so nested calls do not deadlock.
+	 * First exception thrown by body is rethrown to the caller.
+	 */
+	void parallel_for(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t min_chunk = 1);
+};
@@ -0,0 +1,261 @@
+/******************************************************************************
+	 * File: vertex_format.cpp
+	 * Description: Contains vertex layouts and their encoding.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#include <string.h>
+
+#include "vertex_format.h"
+
+namespace Geometry
+{
+	static_assert(sizeof(Vertex) == 24, "Vertex must match R32G32B32 input layout");
+	static_assert(sizeof(Compact_Vertex) == 12, "Compact_Vertex must match R16G16B16A16 + R16G16 input layout");
+
+	namespace
+	{
+		const float unorm16_max = 65535.0f;
+		const float snorm16_max = 32767.0f;
+
+		float clamp(float value, float low, float high)
+		{
+			return value < low ? low : (value > high ? high : value);
+		}
+
+		int16_t to_snorm16(float value)
+		{
+			value = clamp(value, -1.0f, 1.0f) * snorm16_max;
+			return static_cast<int16_t>(value < 0.0f ? value - 0.5f : value + 0.5f);
+		}
+
+		float from_snorm16(int16_t value)
+		{
+			return clamp(static_cast<float>(value) / snorm16_max, -1.0f, 1.0f);
+		}
+
+		uint16_t to_unorm16(float value)
+		{
+			return static_cast<uint16_t>(clamp(value, 0.0f, 1.0f) * unorm16_max + 0.5f);
+		}
+
+		float sign_not_zero(float value)
+		{
+			return value < 0.0f ? -1.0f : 1.0f;
+		}
+	}
+
+	uint16_t float_to_half(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+
+		uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+		uint32_t exponent = (bits >> 23) & 0xFFu;
+		uint32_t mantissa = bits & 0x7FFFFFu;
+
+		// NaN and infinity
+		if (exponent == 0xFFu)
+		{
+			return static_cast<uint16_t>(sign | 0x7C00u | (mantissa != 0 ? 0x200u : 0u));
+		}
+		int half_exponent = static_cast<int>(exponent) - 127 + 15;
+		// Overflow to infinity
+		if (half_exponent >= 31)
+		{
+			return static_cast<uint16_t>(sign | 0x7C00u);
+		}
+		// Normal half, round to nearest even
+		if (half_exponent > 0)
+		{
+			uint32_t result = (static_cast<uint32_t>(half_exponent) << 10) | (mantissa >> 13);
+			uint32_t rest = mantissa & 0x1FFFu;
+			if (rest > 0x1000u || (rest == 0x1000u && (result & 1u)))
+			{
+				++result;
+			}
+			return static_cast<uint16_t>(sign | result);
+		}
+		// Subnormal half or zero
+		if (half_exponent < -10)
+		{
+			return sign;
+		}
+		mantissa |= 0x800000u;
+		uint32_t shift = static_cast<uint32_t>(14 - half_exponent);
+		uint32_t result = mantissa >> shift;
+		uint32_t rest = mantissa & ((1u << shift) - 1u);
+		uint32_t halfway = 1u << (shift - 1u);
+		if (rest > halfway || (rest == halfway && (result & 1u)))
+		{
+			++result;
+		}
+		return static_cast<uint16_t>(sign | result);
+	}
+
+	float half_to_float(uint16_t value)
+	{
+		uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+		uint32_t exponent = (value >> 10) & 0x1Fu;
+		uint32_t mantissa = value & 0x3FFu;
+
+		uint32_t bits;
+		if (exponent == 0x1Fu)
+		{
+			bits = sign | 0x7F800000u | (mantissa << 13);
+		}
+		else if (exponent != 0)
+		{
+			bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+		}
+		else if (mantissa != 0)
+		{
+			// Subnormal half is normal float
+			exponent = 127 - 15 + 1;
+			while (!(mantissa & 0x400u))
+			{
+				mantissa <<= 1;
+				--exponent;
+			}
+			bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+		}
+		else
+		{
+			bits = sign;
+		}
+
+		float result;
+		memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
+
+	void encode_octahedral(const Math_3d::Vector_3d& normal, int16_t* result)
+	{
+		float length = fabsf(normal.x) + fabsf(normal.y) + fabsf(normal.z);
+		if (length == 0.0f)
+		{
+			result[0] = 0;
+			result[1] = 0;
+			return;
+		}
+		// Project to octahedron |x| + |y| + |z| = 1, fold lower half over upper
+		float u = normal.x / length;
+		float v = normal.y / length;
+		if (normal.z < 0.0f)
+		{
+			float folded_u = (1.0f - fabsf(v)) * sign_not_zero(u);
+			float folded_v = (1.0f - fabsf(u)) * sign_not_zero(v);
+			u = folded_u;
+			v = folded_v;
+		}
+		result[0] = to_snorm16(u);
+		result[1] = to_snorm16(v);
+	}
+
+	Math_3d::Vector_3d decode_octahedral(const int16_t* value)
+	{
+		float u = from_snorm16(value[0]);
+		float v = from_snorm16(value[1]);
+		Math_3d::Vector_3d normal(u, v, 1.0f - fabsf(u) - fabsf(v));
+		if (normal.z < 0.0f)
+		{
+			normal.x = (1.0f - fabsf(v)) * sign_not_zero(u);
+			normal.y = (1.0f - fabsf(u)) * sign_not_zero(v);
+		}
+		return normal.normalize();
+	}
+
+	Vertex_Bounds get_vertex_bounds(const Vertex* vertices, size_t count, Vertex_Format format)
+	{
+		Vertex_Bounds bounds;
+		if (count == 0 || format == Vertex_Format::full)
+		{
+			return bounds;
+		}
+
+		Math_3d::Vector_3d low = vertices[0].pos;
+		Math_3d::Vector_3d high = vertices[0].pos;
+		for (size_t i = 1; i < count; ++i)
+		{
+			const Math_3d::Vector_3d& pos = vertices[i].pos;
+			low.x = pos.x < low.x ? pos.x : low.x;
+			low.y = pos.y < low.y ? pos.y : low.y;
+			low.z = pos.z < low.z ? pos.z : low.z;
+			high.x = pos.x > high.x ? pos.x : high.x;
+			high.y = pos.y > high.y ? pos.y : high.y;
+			high.z = pos.z > high.z ? pos.z : high.z;
+		}
+
+		if (format == Vertex_Format::half)
+		{
+			bounds.offset = (low + high) * 0.5f;
+			bounds.scale = (high - low) * 0.5f;
+		}
+		else
+		{
+			bounds.offset = low;
+			bounds.scale = high - low;
+		}
+		return bounds;
+	}
+
+	void encode_vertices(const Vertex* vertices, size_t count, Vertex_Format format,
+						 const Vertex_Bounds& bounds, Compact_Vertex* result)
+	{
+		// Flat axis has zero scale, everything is stored as 0
+		const Math_3d::Vector_3d inv_scale(bounds.scale.x != 0.0f ? 1.0f / bounds.scale.x : 0.0f,
+										   bounds.scale.y != 0.0f ? 1.0f / bounds.scale.y : 0.0f,
+										   bounds.scale.z != 0.0f ? 1.0f / bounds.scale.z : 0.0f);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Math_3d::Vector_3d& pos = vertices[i].pos;
+			float x = (pos.x - bounds.offset.x) * inv_scale.x;
+			float y = (pos.y - bounds.offset.y) * inv_scale.y;
+			float z = (pos.z - bounds.offset.z) * inv_scale.z;
+			if (format == Vertex_Format::half)
+			{
+				result[i].pos[0] = float_to_half(clamp(x, -1.0f, 1.0f));
+				result[i].pos[1] = float_to_half(clamp(y, -1.0f, 1.0f));
+				result[i].pos[2] = float_to_half(clamp(z, -1.0f, 1.0f));
+				result[i].pos[3] = float_to_half(1.0f);
+			}
+			else
+			{
+				result[i].pos[0] = to_unorm16(x);
+				result[i].pos[1] = to_unorm16(y);
+				result[i].pos[2] = to_unorm16(z);
+				result[i].pos[3] = static_cast<uint16_t>(unorm16_max);
+			}
+			encode_octahedral(vertices[i].normal, result[i].normal);
+		}
+	}
+
+	void decode_vertices(const Compact_Vertex* vertices, size_t count, Vertex_Format format,
+						 const Vertex_Bounds& bounds, Vertex* result)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			float x, y, z;
+			if (format == Vertex_Format::half)
+			{
+				x = half_to_float(vertices[i].pos[0]);
+				y = half_to_float(vertices[i].pos[1]);
+				z = half_to_float(vertices[i].pos[2]);
+			}
+			else
+			{
+				x = static_cast<float>(vertices[i].pos[0]) / unorm16_max;
+				y = static_cast<float>(vertices[i].pos[1]) / unorm16_max;
+				z = static_cast<float>(vertices[i].pos[2]) / unorm16_max;
+			}
+			result[i].pos = Math_3d::Vector_3d(bounds.offset.x + bounds.scale.x * x,
+											   bounds.offset.y + bounds.scale.y * y,
+											   bounds.offset.z + bounds.scale.z * z);
+			result[i].normal = decode_octahedral(vertices[i].normal);
+		}
+	}
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+	 * File: vertex_format.h
+	 * Description: Contains vertex layouts and their encoding.
+	 * Created: 16 Oct 2026
+	 * Copyright: (C) 2020 Vyacheslav Smirnov, All rights reserved.
+	 * Author: Vyacheslav Smirnov
+	 * Email: necrolazy@gmail.com
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include "math_3d.h"
+
+namespace Geometry
+{
+	/**
+	* @struct Vertex
+	* Base struct which represents single vertex
+	*/
+	struct Vertex
+	{
+		Math_3d::Vector_3d pos;
+		Math_3d::Vector_3d normal;
+	};
+
+	/**
+	 * Layout of vertices streamed to GPU
+	 */
+	enum class Vertex_Format
+	{
+		/**
+		 * Vertex as is, 24 bytes
+		 */
+		full,
+		/**
+		 * Compact_Vertex, position as half floats in [-1, 1]
+		 * of object bounds, error up to 1/4096 of half extent per axis
+		 */
+		half,
+		/**
+		 * Compact_Vertex, position as 16-bit fixed point over
+		 * object bounds, error up to 1/131070 of extent per axis
+		 */
+		fixed
+	};
+
+	/**
+	* @struct Compact_Vertex
+	* 12 bytes vertex: 16-bit position (DXGI R16G16B16A16 FLOAT
+	* or UNORM, w unused) and octahedral normal (R16G16 SNORM).
+	*/
+	struct Compact_Vertex
+	{
+		uint16_t pos[4];
+		int16_t normal[2];
+	};
+
+	/**
+	* @struct Vertex_Bounds
+	* Decoded position = offset + scale * stored position
+	*/
+	struct Vertex_Bounds
+	{
+		Math_3d::Vector_3d offset;
+		Math_3d::Vector_3d scale = { 1.0f, 1.0f, 1.0f };
+	};
+
+	uint16_t float_to_half(float value);
+	float half_to_float(uint16_t value);
+
+	/**
+	 * Unit vector to two snorm16, octahedral mapping.
+	 * Angular error is below 0.04 degree.
+	 * Zero vector encodes as (0, 0, 1).
+	 */
+	void encode_octahedral(const Math_3d::Vector_3d& normal, int16_t* result);
+	Math_3d::Vector_3d decode_octahedral(const int16_t* value);
+
+	/**
+	 * Bounds which map positions of vertices to stored range of format
+	 */
+	Vertex_Bounds get_vertex_bounds(const Vertex* vertices, size_t count, Vertex_Format format);
+
+	/**
+	 * result[i] = compressed vertices[i], format is half or fixed
+	 */
+	void encode_vertices(const Vertex* vertices, size_t count, Vertex_Format format,
+						 const Vertex_Bounds& bounds, Compact_Vertex* result);
+	/**
+	 * Inverse of encode_vertices, normals are normalized
+	 */
+	void decode_vertices(const Compact_Vertex* vertices, size_t count, Vertex_Format format,
+						 const Vertex_Bounds& bounds, Vertex* result);
+}